@@ -0,0 +1,10 @@
+# Benchmarks are full integration tests built with the benchmark probes
+# compiled into the firmware. They share the googletest harness with the
+# regular tests, but are marked by a `bench.mk` file instead of `test.mk`
+# so that `make test:all` does not pick them up.
+
+TEST_KIND := bench
+
+OPT_DEFS += -DBENCHMARK_PROBES
+
+include builddefs/build_test.mk
@@ -29,6 +29,10 @@ $(TEST)_SRC := \
 	tests/test_common/test_logger.cpp \
 	$(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp))
 
+ifeq ($(TEST_KIND),bench)
+$(TEST)_SRC += tests/test_common/benchmark.cpp
+endif
+
 $(TEST)_DEFS := $(TMK_COMMON_DEFS) $(OPT_DEFS) "-DKEYMAP_C=\"keymap.c\""
 
 $(TEST)_CONFIG := $(TEST_PATH)/config.h
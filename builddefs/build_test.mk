@@ -9,7 +9,9 @@ OPT = g
 include paths.mk
 include $(BUILDDEFS_PATH)/message.mk
 
-TARGET=test/$(TEST)
+TEST_KIND ?= test
+
+TARGET=$(TEST_KIND)/$(TEST)
 
 GTEST_OUTPUT = $(BUILD_DIR)/gtest
 
@@ -53,7 +55,7 @@ endif
 
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
 include tests/test_common/build.mk
-include $(TEST_PATH)/test.mk
+include $(TEST_PATH)/$(TEST_KIND).mk
 endif
 
 include $(BUILDDEFS_PATH)/common_features.mk
@@ -62,8 +64,11 @@ include $(PLATFORM_PATH)/common.mk
 include $(TMK_PATH)/protocol.mk
 include $(QUANTUM_PATH)/debounce/tests/rules.mk
 include $(QUANTUM_PATH)/encoder/tests/rules.mk
+include $(QUANTUM_PATH)/rgb_matrix/tests/rules.mk
 include $(QUANTUM_PATH)/sequencer/tests/rules.mk
+include $(QUANTUM_PATH)/split_common/tests/rules.mk
 include $(QUANTUM_PATH)/wear_leveling/tests/rules.mk
+include $(QUANTUM_PATH)/tests/rules.mk
 include $(QUANTUM_PATH)/logging/print.mk
 include $(PLATFORM_PATH)/test/rules.mk
 ifneq ($(filter $(FULL_TESTS),$(TEST)),)
@@ -83,5 +88,5 @@ include $(PLATFORM_PATH)/$(PLATFORM_KEY)/platform.mk
 include $(BUILDDEFS_PATH)/common_rules.mk
 
 
-$(shell mkdir -p $(BUILD_DIR)/test 2>/dev/null)
+$(shell mkdir -p $(BUILD_DIR)/$(TEST_KIND) 2>/dev/null)
 $(shell mkdir -p $(TEST_OBJ) 2>/dev/null)
@@ -44,6 +44,15 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(DEBUG_TASK_PROFILE_ENABLE)), yes)
+    OPT_DEFS += -DDEBUG_TASK_PROFILE
+    QUANTUM_SRC += $(QUANTUM_DIR)/task_profile.c
+    CONSOLE_ENABLE = yes
+else ifeq ($(strip $(DEBUG_TASK_PROFILE_ENABLE)), api)
+    OPT_DEFS += -DDEBUG_TASK_PROFILE
+    QUANTUM_SRC += $(QUANTUM_DIR)/task_profile.c
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
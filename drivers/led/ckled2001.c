@@ -26,6 +26,10 @@
 #    define CKLED2001_PERSISTENCE 0
 #endif
 
+#if defined(I2C_ASYNC_ENABLE) && CKLED2001_PERSISTENCE > 0
+#    error "CKLED2001_PERSISTENCE is not supported with I2C_ASYNC_ENABLE, failed PWM transfers are sent again with the next update instead"
+#endif
+
 #ifndef PHASE_CHANNEL
 #    define PHASE_CHANNEL MSKPHASE_12CHANNEL
 #endif
@@ -45,7 +49,8 @@ uint8_t g_twi_transfer_buffer[65];
 // buffers and the transfers in CKLED2001_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// One bit per 16 register block of g_pwm_buffer, set when the block changed since it was last written.
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT] = {0};
 
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
@@ -69,36 +74,62 @@ bool CKLED2001_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
-bool CKLED2001_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static bool CKLED2001_write_pwm_blocks(uint8_t addr, uint8_t *pwm_buffer, uint16_t *blocks, uint8_t *written) {
     // Assumes PG1 is already selected.
     // If any of the transactions fails function returns false.
-    // Transmit PWM registers in 3 transfers of 64 bytes.
+    // The bits of the blocks which were transferred are cleared, the others are left to be sent again.
+    // Transmit the PWM registers of each run of up to 4 consecutive blocks of 16 bytes set in blocks in one transfer.
+
+    // Iterate over the pwm_buffer contents at 16 byte intervals.
+    for (uint8_t i = 0; i < 192; i += 16) {
+        if (!(*blocks & (1 << (i / 16)))) {
+            continue;
+        }
+
+        uint8_t length = 16;
+        while (length < 64 && i + length < 192 && (*blocks & (1 << ((i + length) / 16)))) {
+            length += 16;
+        }
 
-    // Iterate over the pwm_buffer contents at 64 byte intervals.
-    for (uint8_t i = 0; i < 192; i += 64) {
         g_twi_transfer_buffer[0] = i;
-        // Copy the data from i to i+63.
+        // Copy the data from i to i+length-1.
         // Device will auto-increment register for data after the first byte
         // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
-        for (uint8_t j = 0; j < 64; j++) {
+        for (uint8_t j = 0; j < length; j++) {
             g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
         }
 
 #if CKLED2001_PERSISTENCE > 0
         for (uint8_t i = 0; i < CKLED2001_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 65, CKLED2001_TIMEOUT) != 0) {
+            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, CKLED2001_TIMEOUT) != 0) {
                 return false;
             }
         }
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 65, CKLED2001_TIMEOUT) != 0) {
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, CKLED2001_TIMEOUT) != 0) {
             return false;
         }
 #endif
+        *blocks &= ~(((1 << (length / 16)) - 1) << (i / 16));
+        *written += length / 16;
+        i += length - 16;
     }
     return true;
 }
 
+bool CKLED2001_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    uint8_t  written = 0;
+    uint16_t blocks  = 0x0FFF;
+    return CKLED2001_write_pwm_blocks(addr, pwm_buffer, &blocks, &written);
+}
+
+static inline void CKLED2001_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver] |= 1 << (reg / 16);
+    }
+}
+
 void CKLED2001_init(uint8_t addr) {
     // Select to function page
     CKLED2001_write_register(addr, CONFIGURE_CMD_PAGE, FUNCTION_PAGE);
@@ -150,10 +181,9 @@ void CKLED2001_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         memcpy_P(&led, (&g_ckled2001_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        CKLED2001_set_pwm_register(led.driver, led.r, red);
+        CKLED2001_set_pwm_register(led.driver, led.g, green);
+        CKLED2001_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -193,17 +223,66 @@ void CKLED2001_set_led_control_register(uint8_t index, bool red, bool green, boo
     g_led_control_registers_update_required[led.driver] = true;
 }
 
-void CKLED2001_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+#ifdef I2C_ASYNC_ENABLE
+// The context of a queued transfer holds the driver index and the PWM blocks it carries
+#    define CKLED2001_TRANSFER_CONTEXT(index, blocks) ((void *)(((uintptr_t)(index) << 12) | (blocks)))
+
+static void CKLED2001_pwm_transfer_done(i2c_status_t status, void *context) {
+    // If any of the transactions fail we risk writing dirty PG0,
+    // refresh page 0 just in case, and send the blocks again.
+    if (status != I2C_STATUS_SUCCESS) {
+        uint8_t index = (uintptr_t)context >> 12;
+        g_pwm_buffer_dirty[index] |= (uintptr_t)context & 0x0FFF;
+        g_led_control_registers_update_required[index] = true;
+    }
+}
+
+static uint8_t CKLED2001_queue_pwm_blocks(uint8_t addr, uint8_t index) {
+    // Same transfers as the blocking update, but queued so they overlap with the scan loop.
+    // The data is copied when queued, so the buffer can be changed straight away.
+    static const uint8_t page_pwm[] = {CONFIGURE_CMD_PAGE, LED_PWM_PAGE};
+    uint8_t              written    = 0;
+
+    // Without the PWM page selected, every block would end up elsewhere
+    i2c_transmit_async(addr << 1, page_pwm, sizeof(page_pwm), CKLED2001_TIMEOUT, CKLED2001_pwm_transfer_done, CKLED2001_TRANSFER_CONTEXT(index, g_pwm_buffer_dirty[index]));
+    for (uint8_t i = 0; i < 192; i += 16) {
+        if (!(g_pwm_buffer_dirty[index] & (1 << (i / 16)))) {
+            continue;
+        }
+
+        // Consecutive blocks are merged into one transfer, as long as it can still be queued
+        uint8_t length = 16;
+        while (length < 64 && i + length < 192 && (g_pwm_buffer_dirty[index] & (1 << ((i + length) / 16)))) {
+            length += 16;
+        }
+
+        uint16_t blocks = ((1 << (length / 16)) - 1) << (i / 16);
+        g_pwm_buffer_dirty[index] &= ~blocks;
+        i2c_writeReg_async(addr << 1, i, &g_pwm_buffer[index][i], length, CKLED2001_TIMEOUT, CKLED2001_pwm_transfer_done, CKLED2001_TRANSFER_CONTEXT(index, blocks));
+        written += length / 16;
+        i += length - 16;
+    }
+    return written;
+}
+#endif
+
+uint8_t CKLED2001_update_pwm_buffers(uint8_t addr, uint8_t index) {
+    uint8_t written = 0;
+    if (g_pwm_buffer_dirty[index]) {
+#ifdef I2C_ASYNC_ENABLE
+        written = CKLED2001_queue_pwm_blocks(addr, index);
+#else
         CKLED2001_write_register(addr, CONFIGURE_CMD_PAGE, LED_PWM_PAGE);
 
+        // Only the blocks which changed are written.
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
-        if (!CKLED2001_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        if (!CKLED2001_write_pwm_blocks(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty[index], &written)) {
             g_led_control_registers_update_required[index] = true;
         }
+#endif
     }
-    g_pwm_buffer_update_required[index] = false;
+    return written;
 }
 
 void CKLED2001_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -41,9 +41,10 @@ void CKLED2001_set_led_control_register(uint8_t index, bool red, bool green, boo
 // This should not be called from an interrupt
 // (eg. from a timer interrupt).
 // Call this while idle (in between matrix scans).
-// If the buffer is dirty, it will update the driver with the buffer.
-void CKLED2001_update_pwm_buffers(uint8_t addr, uint8_t index);
-void CKLED2001_update_led_control_registers(uint8_t addr, uint8_t index);
+// Only the blocks of the buffer which changed are sent to the driver.
+// Returns the number of blocks of 16 PWM registers that were written.
+uint8_t CKLED2001_update_pwm_buffers(uint8_t addr, uint8_t index);
+void    CKLED2001_update_led_control_registers(uint8_t addr, uint8_t index);
 
 void CKLED2001_sw_return_normal(uint8_t addr);
 void CKLED2001_sw_shutdown(uint8_t addr);
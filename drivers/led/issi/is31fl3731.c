@@ -57,6 +57,10 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+#if defined(I2C_ASYNC_ENABLE) && ISSI_PERSISTENCE > 0
+#    error "ISSI_PERSISTENCE is not supported with I2C_ASYNC_ENABLE, failed PWM transfers are sent again with the next update instead"
+#endif
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20];
 
@@ -66,7 +70,8 @@ uint8_t g_twi_transfer_buffer[20];
 // buffers and the transfers in IS31FL3731_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[DRIVER_COUNT][144];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// One bit per 16 register block of g_pwm_buffer, set when the block changed since it was last written.
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT] = {0};
 
 uint8_t g_led_control_registers[DRIVER_COUNT][18]             = {{0}};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
@@ -98,14 +103,20 @@ void IS31FL3731_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static uint8_t IS31FL3731_write_pwm_blocks(uint8_t addr, uint8_t *pwm_buffer, uint16_t *blocks) {
     // assumes bank is already selected
 
-    // transmit PWM registers in 9 transfers of 16 bytes
+    // transmit the PWM registers of each block set in blocks in a transfer of 16 bytes,
+    // clearing the bits of the blocks which were transferred
     // g_twi_transfer_buffer[] is 20 bytes
+    uint8_t written = 0;
 
     // iterate over the pwm_buffer contents at 16 byte intervals
     for (int i = 0; i < 144; i += 16) {
+        if (!(*blocks & (1 << (i / 16)))) {
+            continue;
+        }
+
         // set the first register, e.g. 0x24, 0x34, 0x44, etc.
         g_twi_transfer_buffer[0] = 0x24 + i;
         // copy the data from i to i+15
@@ -115,13 +126,32 @@ void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
             g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
         }
 
+        i2c_status_t status;
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+            if ((status = i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT)) == 0) break;
         }
 #else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
+        status = i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
 #endif
+        // a block which failed stays dirty, so it is sent again with the next update
+        if (status == 0) {
+            *blocks &= ~(1 << (i / 16));
+            written++;
+        }
+    }
+    return written;
+}
+
+void IS31FL3731_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    uint16_t blocks = 0x01FF;
+    IS31FL3731_write_pwm_blocks(addr, pwm_buffer, &blocks);
+}
+
+static inline void IS31FL3731_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver] |= 1 << (reg / 16);
     }
 }
 
@@ -186,10 +216,9 @@ void IS31FL3731_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
         // Subtract 0x24 to get the second index of g_pwm_buffer
-        g_pwm_buffer[led.driver][led.r - 0x24]   = red;
-        g_pwm_buffer[led.driver][led.g - 0x24]   = green;
-        g_pwm_buffer[led.driver][led.b - 0x24]   = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3731_set_pwm_register(led.driver, led.r - 0x24, red);
+        IS31FL3731_set_pwm_register(led.driver, led.g - 0x24, green);
+        IS31FL3731_set_pwm_register(led.driver, led.b - 0x24, blue);
     }
 }
 
@@ -229,11 +258,37 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
     g_led_control_registers_update_required[led.driver] = true;
 }
 
-void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        IS31FL3731_write_pwm_buffer(addr, g_pwm_buffer[index]);
+#ifdef I2C_ASYNC_ENABLE
+// The context of a queued transfer holds the driver index and the PWM blocks it carries
+#    define IS31FL3731_TRANSFER_CONTEXT(index, blocks) ((void *)(((uintptr_t)(index) << 12) | (blocks)))
+
+static void IS31FL3731_pwm_transfer_done(i2c_status_t status, void *context) {
+    // a block which failed is marked dirty again, so it is sent again with the next update
+    if (status != I2C_STATUS_SUCCESS) {
+        g_pwm_buffer_dirty[(uintptr_t)context >> 12] |= (uintptr_t)context & 0x0FFF;
+    }
+}
+#endif
+
+uint8_t IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index) {
+    uint8_t written = 0;
+    if (g_pwm_buffer_dirty[index]) {
+        // only the blocks which changed are written
+#ifdef I2C_ASYNC_ENABLE
+        // queued rather than waited for, the data is copied so the buffer can be changed straight away
+        for (int i = 0; i < 144; i += 16) {
+            uint16_t block = 1 << (i / 16);
+            if (g_pwm_buffer_dirty[index] & block) {
+                g_pwm_buffer_dirty[index] &= ~block;
+                i2c_writeReg_async(addr << 1, 0x24 + i, &g_pwm_buffer[index][i], 16, ISSI_TIMEOUT, IS31FL3731_pwm_transfer_done, IS31FL3731_TRANSFER_CONTEXT(index, block));
+                written++;
+            }
+        }
+#else
+        written = IS31FL3731_write_pwm_blocks(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty[index]);
+#endif
     }
-    g_pwm_buffer_update_required[index] = false;
+    return written;
 }
 
 void IS31FL3731_update_led_control_registers(uint8_t addr, uint8_t index) {
@@ -42,9 +42,10 @@ void IS31FL3731_set_led_control_register(uint8_t index, bool red, bool green, bo
 // This should not be called from an interrupt
 // (eg. from a timer interrupt).
 // Call this while idle (in between matrix scans).
-// If the buffer is dirty, it will update the driver with the buffer.
-void IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index);
-void IS31FL3731_update_led_control_registers(uint8_t addr, uint8_t index);
+// Only the blocks of the buffer which changed are sent to the driver.
+// Returns the number of blocks of 16 PWM registers that were written.
+uint8_t IS31FL3731_update_pwm_buffers(uint8_t addr, uint8_t index);
+void    IS31FL3731_update_led_control_registers(uint8_t addr, uint8_t index);
 
 #define C1_1 0x24
 #define C1_2 0x25
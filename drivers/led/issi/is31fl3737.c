@@ -57,6 +57,10 @@
 #    define ISSI_PERSISTENCE 0
 #endif
 
+#if defined(I2C_ASYNC_ENABLE) && ISSI_PERSISTENCE > 0
+#    error "ISSI_PERSISTENCE is not supported with I2C_ASYNC_ENABLE, failed PWM transfers are sent again with the next update instead"
+#endif
+
 #ifndef ISSI_PWM_FREQUENCY
 #    define ISSI_PWM_FREQUENCY 0b000 // PFS - IS31FL3737B only
 #endif
@@ -84,7 +88,8 @@ uint8_t g_twi_transfer_buffer[20];
 // probably not worth the extra complexity.
 
 uint8_t g_pwm_buffer[DRIVER_COUNT][192];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// One bit per 16 register block of g_pwm_buffer, set when the block changed since it was last written.
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT] = {0};
 
 uint8_t g_led_control_registers[DRIVER_COUNT][24]             = {0};
 bool    g_led_control_registers_update_required[DRIVER_COUNT] = {false};
@@ -102,14 +107,20 @@ void IS31FL3737_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-void IS31FL3737_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+static uint8_t IS31FL3737_write_pwm_blocks(uint8_t addr, uint8_t *pwm_buffer, uint16_t *blocks) {
     // assumes PG1 is already selected
 
-    // transmit PWM registers in 12 transfers of 16 bytes
+    // transmit the PWM registers of each block set in blocks in a transfer of 16 bytes,
+    // clearing the bits of the blocks which were transferred
     // g_twi_transfer_buffer[] is 20 bytes
+    uint8_t written = 0;
 
     // iterate over the pwm_buffer contents at 16 byte intervals
     for (int i = 0; i < 192; i += 16) {
+        if (!(*blocks & (1 << (i / 16)))) {
+            continue;
+        }
+
         g_twi_transfer_buffer[0] = i;
         // copy the data from i to i+15
         // device will auto-increment register for data after the first byte
@@ -118,13 +129,32 @@ void IS31FL3737_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
             g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
         }
 
+        i2c_status_t status;
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT) == 0) break;
+            if ((status = i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT)) == 0) break;
         }
 #else
-        i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
+        status = i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, ISSI_TIMEOUT);
 #endif
+        // a block which failed stays dirty, so it is sent again with the next update
+        if (status == 0) {
+            *blocks &= ~(1 << (i / 16));
+            written++;
+        }
+    }
+    return written;
+}
+
+void IS31FL3737_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    uint16_t blocks = 0x0FFF;
+    IS31FL3737_write_pwm_blocks(addr, pwm_buffer, &blocks);
+}
+
+static inline void IS31FL3737_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver] |= 1 << (reg / 16);
     }
 }
 
@@ -178,10 +208,9 @@ void IS31FL3737_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3737_set_pwm_register(led.driver, led.r, red);
+        IS31FL3737_set_pwm_register(led.driver, led.g, green);
+        IS31FL3737_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -221,15 +250,58 @@ void IS31FL3737_set_led_control_register(uint8_t index, bool red, bool green, bo
     g_led_control_registers_update_required[led.driver] = true;
 }
 
-void IS31FL3737_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+#ifdef I2C_ASYNC_ENABLE
+// The context of a queued transfer holds the driver index and the PWM blocks it carries
+#    define IS31FL3737_TRANSFER_CONTEXT(index, blocks) ((void *)(((uintptr_t)(index) << 12) | (blocks)))
+
+static void IS31FL3737_pwm_transfer_done(i2c_status_t status, void *context) {
+    // If any of the transactions fail we risk writing dirty PG0,
+    // refresh page 0 just in case, and send the blocks again.
+    if (status != I2C_STATUS_SUCCESS) {
+        uint8_t index = (uintptr_t)context >> 12;
+        g_pwm_buffer_dirty[index] |= (uintptr_t)context & 0x0FFF;
+        g_led_control_registers_update_required[index] = true;
+    }
+}
+
+static uint8_t IS31FL3737_queue_pwm_blocks(uint8_t addr, uint8_t index) {
+    // Same transfers as the blocking update, but queued so they overlap with the scan loop.
+    // The data is copied when queued, so the buffer can be changed straight away.
+    static const uint8_t unlock[]   = {ISSI_COMMANDREGISTER_WRITELOCK, 0xC5};
+    static const uint8_t page_pwm[] = {ISSI_COMMANDREGISTER, ISSI_PAGE_PWM};
+    uint8_t              written    = 0;
+
+    // Without PG1 selected, every block would end up elsewhere
+    void *all_blocks = IS31FL3737_TRANSFER_CONTEXT(index, g_pwm_buffer_dirty[index]);
+    i2c_transmit_async(addr << 1, unlock, sizeof(unlock), ISSI_TIMEOUT, IS31FL3737_pwm_transfer_done, all_blocks);
+    i2c_transmit_async(addr << 1, page_pwm, sizeof(page_pwm), ISSI_TIMEOUT, IS31FL3737_pwm_transfer_done, all_blocks);
+    for (int i = 0; i < 192; i += 16) {
+        uint16_t block = 1 << (i / 16);
+        if (g_pwm_buffer_dirty[index] & block) {
+            g_pwm_buffer_dirty[index] &= ~block;
+            i2c_writeReg_async(addr << 1, i, &g_pwm_buffer[index][i], 16, ISSI_TIMEOUT, IS31FL3737_pwm_transfer_done, IS31FL3737_TRANSFER_CONTEXT(index, block));
+            written++;
+        }
+    }
+    return written;
+}
+#endif
+
+uint8_t IS31FL3737_update_pwm_buffers(uint8_t addr, uint8_t index) {
+    uint8_t written = 0;
+    if (g_pwm_buffer_dirty[index]) {
+#ifdef I2C_ASYNC_ENABLE
+        written = IS31FL3737_queue_pwm_blocks(addr, index);
+#else
         // Firstly we need to unlock the command register and select PG1
         IS31FL3737_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
         IS31FL3737_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM);
 
-        IS31FL3737_write_pwm_buffer(addr, g_pwm_buffer[index]);
+        // Only the blocks which changed are written
+        written = IS31FL3737_write_pwm_blocks(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty[index]);
+#endif
     }
-    g_pwm_buffer_update_required[index] = false;
+    return written;
 }
 
 void IS31FL3737_update_led_control_registers(uint8_t addr, uint8_t index) {
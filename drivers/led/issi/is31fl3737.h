@@ -44,9 +44,10 @@ void IS31FL3737_set_led_control_register(uint8_t index, bool red, bool green, bo
 // This should not be called from an interrupt
 // (eg. from a timer interrupt).
 // Call this while idle (in between matrix scans).
-// If the buffer is dirty, it will update the driver with the buffer.
-void IS31FL3737_update_pwm_buffers(uint8_t addr1, uint8_t addr2);
-void IS31FL3737_update_led_control_registers(uint8_t addr1, uint8_t addr2);
+// Only the blocks of the buffer which changed are sent to the driver.
+// Returns the number of blocks of 16 PWM registers that were written.
+uint8_t IS31FL3737_update_pwm_buffers(uint8_t addr, uint8_t index);
+void    IS31FL3737_update_led_control_registers(uint8_t addr1, uint8_t addr2);
 
 #define PUR_0R 0x00   // No PUR resistor
 #define PUR_05KR 0x01 // 0.5k Ohm resistor in t_NOL
@@ -75,6 +75,10 @@
 
 #define ISSI_MAX_LEDS 351
 
+// PWM registers are written in blocks of 18, PG0 holds the first 10 blocks and PG1 the rest
+#define ISSI_PWM_BLOCK_SIZE 18
+#define ISSI_PWM_PAGE_SIZE 180
+
 // Transfer buffer for TWITransmitData()
 uint8_t g_twi_transfer_buffer[20] = {0xFF};
 
@@ -85,8 +89,9 @@ uint8_t g_twi_transfer_buffer[20] = {0xFF};
 // buffers and the transfers in IS31FL3741_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT]        = {false};
-bool    g_scaling_registers_update_required[DRIVER_COUNT] = {false};
+// One bit per 18 register block of g_pwm_buffer, set when the block changed since it was last written.
+uint32_t g_pwm_buffer_dirty[DRIVER_COUNT]                  = {0};
+bool     g_scaling_registers_update_required[DRIVER_COUNT] = {false};
 
 uint8_t g_scaling_registers[DRIVER_COUNT][ISSI_MAX_LEDS];
 
@@ -103,51 +108,59 @@ void IS31FL3741_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
 #endif
 }
 
-bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
-    // unlock the command register and select PG2
-    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-    IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM0);
+static bool IS31FL3741_write_pwm_blocks(uint8_t addr, uint8_t *pwm_buffer, uint32_t *blocks, uint8_t *written) {
+    // If any of the transactions fails function returns false.
+    // The bits of the blocks which were transferred are cleared, the others are left to be sent again.
+    // A page is only selected when one of its blocks is written.
+    int page = -1;
 
-    for (int i = 0; i < 342; i += 18) {
-        if (i == 180) {
-            // unlock the command register and select PG2
+    for (int i = 0; i < ISSI_MAX_LEDS; i += ISSI_PWM_BLOCK_SIZE) {
+        uint32_t block = 1UL << (i / ISSI_PWM_BLOCK_SIZE);
+        if (!(*blocks & block)) {
+            continue;
+        }
+
+        if (page != i / ISSI_PWM_PAGE_SIZE) {
+            page = i / ISSI_PWM_PAGE_SIZE;
+            // unlock the command register and select PG0 or PG1
             IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, 0xC5);
-            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, ISSI_PAGE_PWM1);
+            IS31FL3741_write_register(addr, ISSI_COMMANDREGISTER, page ? ISSI_PAGE_PWM1 : ISSI_PAGE_PWM0);
         }
 
-        g_twi_transfer_buffer[0] = i % 180;
-        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 18);
+        // The last block only has the 9 registers left over, as the total number is 351
+        uint8_t length           = ISSI_MAX_LEDS - i < ISSI_PWM_BLOCK_SIZE ? ISSI_MAX_LEDS - i : ISSI_PWM_BLOCK_SIZE;
+        g_twi_transfer_buffer[0] = i % ISSI_PWM_PAGE_SIZE;
+        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, length);
 
 #if ISSI_PERSISTENCE > 0
         for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
+            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) != 0) {
                 return false;
             }
         }
 #else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 19, ISSI_TIMEOUT) != 0) {
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, ISSI_TIMEOUT) != 0) {
             return false;
         }
 #endif
+        *blocks &= ~block;
+        (*written)++;
     }
 
-    // transfer the left cause the total number is 351
-    g_twi_transfer_buffer[0] = 162;
-    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + 342, 9);
+    return true;
+}
 
-#if ISSI_PERSISTENCE > 0
-    for (uint8_t i = 0; i < ISSI_PERSISTENCE; i++) {
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
-            return false;
-        }
-    }
-#else
-    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 10, ISSI_TIMEOUT) != 0) {
-        return false;
-    }
-#endif
+bool IS31FL3741_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
+    uint8_t  written = 0;
+    uint32_t blocks  = (1UL << ((ISSI_MAX_LEDS + ISSI_PWM_BLOCK_SIZE - 1) / ISSI_PWM_BLOCK_SIZE)) - 1;
+    return IS31FL3741_write_pwm_blocks(addr, pwm_buffer, &blocks, &written);
+}
 
-    return true;
+static inline void IS31FL3741_set_pwm_register(uint8_t driver, uint16_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver] |= 1UL << (reg / ISSI_PWM_BLOCK_SIZE);
+    }
 }
 
 void IS31FL3741_init(uint8_t addr) {
@@ -182,10 +195,9 @@ void IS31FL3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL3741_set_pwm_register(led.driver, led.r, red);
+        IS31FL3741_set_pwm_register(led.driver, led.g, green);
+        IS31FL3741_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -220,20 +232,19 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
     g_scaling_registers_update_required[led.driver] = true;
 }
 
-void IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        IS31FL3741_write_pwm_buffer(addr, g_pwm_buffer[index]);
+uint8_t IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index) {
+    uint8_t written = 0;
+    if (g_pwm_buffer_dirty[index]) {
+        // Only the blocks which changed are written, failed ones are sent again with the next update.
+        IS31FL3741_write_pwm_blocks(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty[index], &written);
     }
-
-    g_pwm_buffer_update_required[index] = false;
+    return written;
 }
 
 void IS31FL3741_set_pwm_buffer(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue) {
-    g_pwm_buffer[pled->driver][pled->r] = red;
-    g_pwm_buffer[pled->driver][pled->g] = green;
-    g_pwm_buffer[pled->driver][pled->b] = blue;
-
-    g_pwm_buffer_update_required[pled->driver] = true;
+    IS31FL3741_set_pwm_register(pled->driver, pled->r, red);
+    IS31FL3741_set_pwm_register(pled->driver, pled->g, green);
+    IS31FL3741_set_pwm_register(pled->driver, pled->b, blue);
 }
 
 void IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index) {
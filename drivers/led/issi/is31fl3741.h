@@ -44,10 +44,11 @@ void IS31FL3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 // This should not be called from an interrupt
 // (eg. from a timer interrupt).
 // Call this while idle (in between matrix scans).
-// If the buffer is dirty, it will update the driver with the buffer.
-void IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index);
-void IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index);
-void IS31FL3741_set_scaling_registers(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue);
+// Only the blocks of the buffer which changed are sent to the driver.
+// Returns the number of blocks of 18 PWM registers that were written.
+uint8_t IS31FL3741_update_pwm_buffers(uint8_t addr, uint8_t index);
+void    IS31FL3741_update_led_control_registers(uint8_t addr, uint8_t index);
+void    IS31FL3741_set_scaling_registers(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue);
 
 void IS31FL3741_set_pwm_buffer(const is31_led *pled, uint8_t red, uint8_t green, uint8_t blue);
 
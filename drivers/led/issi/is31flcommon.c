@@ -37,7 +37,10 @@ uint8_t g_twi_transfer_buffer[20];
 // These buffers match the PWM & scaling registers.
 // Storing them like this is optimal for I2C transfers to the registers.
 uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+// One bit per ISSI_PWM_TRF_SIZE register block of g_pwm_buffer, set when the block changed since it was last written.
+uint16_t g_pwm_buffer_dirty[DRIVER_COUNT] = {0};
+
+_Static_assert((ISSI_MAX_LEDS + ISSI_PWM_TRF_SIZE - 1) / ISSI_PWM_TRF_SIZE <= 16, "Too many PWM register blocks to track");
 
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
@@ -83,6 +86,30 @@ bool IS31FL_write_multi_registers(uint8_t addr, uint8_t *source_buffer, uint8_t
     return true;
 }
 
+static bool IS31FL_write_pwm_blocks(uint8_t addr, uint8_t *pwm_buffer, uint16_t *blocks, uint8_t *written) {
+    // The bits of the blocks which were transferred are cleared, the others are left to be sent again.
+    for (int i = 0; i < ISSI_MAX_LEDS; i += ISSI_PWM_TRF_SIZE) {
+        uint16_t block = 1 << (i / ISSI_PWM_TRF_SIZE);
+        if (!(*blocks & block)) {
+            continue;
+        }
+
+        if (!IS31FL_write_multi_registers(addr, pwm_buffer + i, ISSI_PWM_TRF_SIZE, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST + i)) {
+            return false;
+        }
+        *blocks &= ~block;
+        (*written)++;
+    }
+    return true;
+}
+
+static inline void IS31FL_set_pwm_register(uint8_t driver, uint8_t reg, uint8_t value) {
+    if (g_pwm_buffer[driver][reg] != value) {
+        g_pwm_buffer[driver][reg] = value;
+        g_pwm_buffer_dirty[driver] |= 1 << (reg / ISSI_PWM_TRF_SIZE);
+    }
+}
+
 void IS31FL_unlock_register(uint8_t addr, uint8_t page) {
     // unlock the command register and select Page to write
     IS31FL_write_single_register(addr, ISSI_COMMANDREGISTER_WRITELOCK, ISSI_REGISTER_UNLOCK);
@@ -120,15 +147,15 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     wait_ms(10);
 }
 
-void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+uint8_t IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
+    uint8_t written = 0;
+    if (g_pwm_buffer_dirty[index]) {
         // Queue up the correct page
         IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
-        // Update flags that pwm_buffer has been updated
-        g_pwm_buffer_update_required[index] = false;
+        // Only the blocks which changed are written, failed ones are sent again with the next update
+        IS31FL_write_pwm_blocks(addr, g_pwm_buffer[index], &g_pwm_buffer_dirty[index], &written);
     }
+    return written;
 }
 
 #ifdef ISSI_MANUAL_SCALING
@@ -171,10 +198,9 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm_register(led.driver, led.r, red);
+        IS31FL_set_pwm_register(led.driver, led.g, green);
+        IS31FL_set_pwm_register(led.driver, led.b, blue);
     }
 }
 
@@ -220,8 +246,7 @@ void IS31FL_simple_set_scaling_buffer(uint8_t index, bool value) {
 void IS31FL_simple_set_brightness(int index, uint8_t value) {
     if (index >= 0 && index < LED_MATRIX_LED_COUNT) {
         is31_led led = g_is31_leds[index];
-        g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        IS31FL_set_pwm_register(led.driver, led.v, value);
     }
 }
 
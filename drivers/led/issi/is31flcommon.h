@@ -64,8 +64,10 @@ bool IS31FL_write_multi_registers(uint8_t addr, uint8_t *source_buffer, uint8_t
 void IS31FL_unlock_register(uint8_t addr, uint8_t page);
 void IS31FL_common_init(uint8_t addr, uint8_t ssr);
 
-void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index);
-void IS31FL_common_update_scaling_register(uint8_t addr, uint8_t index);
+// Only the blocks of the PWM buffer which changed are sent to the driver.
+// Returns the number of blocks of ISSI_PWM_TRF_SIZE registers that were written.
+uint8_t IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index);
+void    IS31FL_common_update_scaling_register(uint8_t addr, uint8_t index);
 
 #ifdef RGB_MATRIX_ENABLE
 // RGB Matrix Specific scripts
@@ -102,6 +102,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #endif // defined(__AVR__)
 #define I2C_TRANSMIT(data) i2c_transmit((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT)
 #define I2C_WRITE_REG(mode, data, size) i2c_writeReg((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT)
+#ifdef I2C_ASYNC_ENABLE
+// Rendered blocks are queued, a failed transfer marks its block dirty again
+#    define I2C_RENDER_TRANSMIT(data, block) i2c_transmit_async((OLED_DISPLAY_ADDRESS << 1), &data[0], sizeof(data), OLED_I2C_TIMEOUT, oled_render_done, (void *)(uintptr_t)(block))
+#    define I2C_RENDER_WRITE_REG(mode, data, size, block) i2c_writeReg_async((OLED_DISPLAY_ADDRESS << 1), mode, data, size, OLED_I2C_TIMEOUT, oled_render_done, (void *)(uintptr_t)(block))
+#else
+#    define I2C_RENDER_TRANSMIT(data, block) I2C_TRANSMIT(data)
+#    define I2C_RENDER_WRITE_REG(mode, data, size, block) I2C_WRITE_REG(mode, data, size)
+#endif
 
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 
@@ -151,6 +159,14 @@ static i2c_status_t i2c_transmit_P(uint8_t address, const uint8_t *data, uint16_
 }
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+static void oled_render_done(i2c_status_t status, void *context) {
+    if (status != I2C_STATUS_SUCCESS) {
+        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (uintptr_t)context);
+    }
+}
+#endif
+
 // Flips the rendering bits for a character at the current cursor position
 static void InvertCharacter(uint8_t *cursor) {
     const uint8_t *end = cursor + OLED_FONT_WIDTH;
@@ -317,14 +333,14 @@ void oled_render(void) {
         }
 
         // Send column & page position
-        if (I2C_TRANSMIT(display_start) != I2C_STATUS_SUCCESS) {
+        if (I2C_RENDER_TRANSMIT(display_start, update_start) != I2C_STATUS_SUCCESS) {
             print("oled_render offset command failed\n");
             return;
         }
 
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (I2C_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+            if (I2C_RENDER_WRITE_REG(I2C_DATA, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE, update_start) != I2C_STATUS_SUCCESS) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -340,7 +356,7 @@ void oled_render(void) {
             }
 
             // Send render data chunk after rotating
-            if (I2C_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE) != I2C_STATUS_SUCCESS) {
+            if (I2C_RENDER_WRITE_REG(I2C_DATA, &temp_buffer[0], OLED_BLOCK_SIZE, update_start) != I2C_STATUS_SUCCESS) {
                 print("oled_render90 data failed\n");
                 return;
             }
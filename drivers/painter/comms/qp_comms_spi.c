@@ -3,6 +3,7 @@
 
 #ifdef QUANTUM_PAINTER_SPI_ENABLE
 
+#    include <string.h>
 #    include "spi_master.h"
 #    include "qp_comms_spi.h"
 
@@ -30,6 +31,34 @@ bool qp_comms_spi_start(painter_device_t device) {
     return spi_start(comms_config->chip_select_pin, comms_config->lsb_first, comms_config->mode, comms_config->divisor);
 }
 
+#    ifdef SPI_ASYNC_ENABLE
+
+// Alternating DMA buffers -- one is in flight while the other is being filled
+static uint8_t spi_dma_buffers[2][QUANTUM_PAINTER_SPI_DMA_BUFFER_SIZE];
+static uint8_t spi_dma_buffer_index = 0;
+
+uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
+    uint32_t       bytes_remaining = byte_count;
+    const uint8_t *p               = (const uint8_t *)data;
+    while (bytes_remaining > 0) {
+        uint32_t bytes_this_loop = bytes_remaining < QUANTUM_PAINTER_SPI_DMA_BUFFER_SIZE ? bytes_remaining : QUANTUM_PAINTER_SPI_DMA_BUFFER_SIZE;
+
+        // The transfer which last used this buffer has already completed, as starting the following one waited for it
+        uint8_t *buffer = spi_dma_buffers[spi_dma_buffer_index];
+        spi_dma_buffer_index ^= 1;
+        memcpy(buffer, p, bytes_this_loop);
+        spi_transmit_async(buffer, bytes_this_loop);
+
+        p += bytes_this_loop;
+        bytes_remaining -= bytes_this_loop;
+    }
+
+    // Return without waiting, so the caller can prepare the next chunk of data while this one is transmitted
+    return byte_count - bytes_remaining;
+}
+
+#    else // SPI_ASYNC_ENABLE
+
 uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
     uint32_t       bytes_remaining = byte_count;
     const uint8_t *p               = (const uint8_t *)data;
@@ -43,6 +72,8 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+#    endif // SPI_ASYNC_ENABLE
+
 void qp_comms_spi_stop(painter_device_t device) {
     struct painter_driver_t *     driver       = (struct painter_driver_t *)device;
     struct qp_comms_spi_config_t *comms_config = (struct qp_comms_spi_config_t *)driver->comms_config;
@@ -98,6 +129,10 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     struct painter_driver_t *              driver       = (struct painter_driver_t *)device;
     struct qp_comms_spi_dc_reset_config_t *comms_config = (struct qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+#        ifdef SPI_ASYNC_ENABLE
+    // Any pixel data still in flight needs to be sent as data, not as a command
+    spi_async_wait();
+#        endif
     writePinLow(comms_config->dc_pin);
     spi_write(cmd);
 }
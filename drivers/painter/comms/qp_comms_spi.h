@@ -10,6 +10,17 @@
 #    include "gpio.h"
 #    include "qp_internal.h"
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter SPI configurables (add to your keyboard's config.h)
+
+#    ifndef QUANTUM_PAINTER_SPI_DMA_BUFFER_SIZE
+/**
+ * @def The size of each of the two buffers used to stream data to the display using DMA, when SPI_ASYNC_ENABLE is
+ *      defined. Larger transfers are split into chunks of this size.
+ */
+#        define QUANTUM_PAINTER_SPI_DMA_BUFFER_SIZE 1024
+#    endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
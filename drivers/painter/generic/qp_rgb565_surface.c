@@ -3,6 +3,7 @@
 #include "color.h"
 #include "qp_rgb565_surface.h"
 #include "qp_draw.h"
+#include "qp_comms.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Common
@@ -24,12 +25,11 @@ typedef struct rgb565_surface_painter_device_t {
     uint16_t pixdata_x;
     uint16_t pixdata_y;
 
-    // Maintain a dirty region so we can stream only what we need
+    // Maintain a map of dirty tiles so we can stream only what we need -- one bit per tile column, for each row of tiles
     bool     is_dirty;
-    uint16_t dirty_l;
-    uint16_t dirty_t;
-    uint16_t dirty_r;
-    uint16_t dirty_b;
+    uint16_t tile_width;
+    uint16_t tile_height;
+    uint32_t dirty_tiles[RGB565_SURFACE_MAX_TILE_ROWS];
 
 } rgb565_surface_painter_device_t;
 
@@ -58,19 +58,8 @@ static inline void increment_pixdata_location(rgb565_surface_painter_device_t *s
 static inline void setpixel(rgb565_surface_painter_device_t *surface, uint16_t x, uint16_t y, uint16_t rgb565) {
     // Skip messing with the dirty info if the original value already matches
     if (surface->buffer[y * surface->base.panel_width + x] != rgb565) {
-        // Maintain dirty region
-        if (surface->dirty_l > x) {
-            surface->dirty_l = x;
-        }
-        if (surface->dirty_r < x) {
-            surface->dirty_r = x;
-        }
-        if (surface->dirty_t > y) {
-            surface->dirty_t = y;
-        }
-        if (surface->dirty_b < y) {
-            surface->dirty_b = y;
-        }
+        // Maintain dirty tiles
+        surface->dirty_tiles[y / surface->tile_height] |= 1UL << (x / surface->tile_width);
 
         // Always dirty after a setpixel
         surface->is_dirty = true;
@@ -115,9 +104,8 @@ static bool qp_rgb565_surface_clear(painter_device_t device) {
 static bool qp_rgb565_surface_flush(painter_device_t device) {
     struct painter_driver_t *        driver  = (struct painter_driver_t *)device;
     rgb565_surface_painter_device_t *surface = (rgb565_surface_painter_device_t *)driver;
-    surface->dirty_l = surface->dirty_t = UINT16_MAX;
-    surface->dirty_r = surface->dirty_b = 0;
-    surface->is_dirty                   = false;
+    memset(surface->dirty_tiles, 0, sizeof(surface->dirty_tiles));
+    surface->is_dirty = false;
     return true;
 }
 
@@ -217,6 +205,10 @@ painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_hei
             driver->base.offset_x              = 0;
             driver->base.offset_y              = 0;
             driver->buffer                     = (uint16_t *)buffer;
+
+            // Larger surfaces use larger tiles, so that the dirty tile map still covers the whole surface
+            driver->tile_width  = QP_MAX(RGB565_SURFACE_TILE_SIZE, (panel_width + 31) / 32);
+            driver->tile_height = QP_MAX(RGB565_SURFACE_TILE_SIZE, (panel_height + RGB565_SURFACE_MAX_TILE_ROWS - 1) / RGB565_SURFACE_MAX_TILE_ROWS);
             return (painter_device_t)driver;
         }
     }
@@ -226,36 +218,33 @@ painter_device_t qp_rgb565_make_surface(uint16_t panel_width, uint16_t panel_hei
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Drawing routine to copy out the dirty region and send it to another device
 
-bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
-    struct painter_driver_t *        surface_driver = (struct painter_driver_t *)surface;
-    rgb565_surface_painter_device_t *surface_handle = (rgb565_surface_painter_device_t *)surface_driver;
-
-    // If we're not dirty... we're done.
-    if (!surface_handle->is_dirty) {
-        return true;
-    }
-
-    // Set the target drawing area
-    bool ok = qp_viewport(display, x + surface_handle->dirty_l, y + surface_handle->dirty_t, x + surface_handle->dirty_r, y + surface_handle->dirty_b);
-    if (!ok) {
-        return false;
-    }
+// Streams a rectangular area of the surface to the current viewport of the display
+static bool stream_region(rgb565_surface_painter_device_t *surface, painter_device_t display, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    struct painter_driver_t *display_driver = (struct painter_driver_t *)display;
 
     // Housekeeping of the amount of pixels to transfer
     uint32_t  total_pixel_count = QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE / sizeof(uint16_t);
     uint32_t  pixel_counter     = 0;
     uint16_t *target_buffer     = (uint16_t *)qp_internal_global_pixdata_buffer;
 
-    // Fill the global pixdata area so that we can start transferring to the panel
-    for (uint16_t y = surface_handle->dirty_t; y <= surface_handle->dirty_b; ++y) {
-        for (uint16_t x = surface_handle->dirty_l; x <= surface_handle->dirty_r; ++x) {
-            // Update the target buffer
-            target_buffer[pixel_counter++] = surface_handle->buffer[y * surface_handle->base.panel_width + x];
+    // Fill the global pixdata area a row at a time -- with asynchronous comms, the previous chunk is still being
+    // transferred to the panel while the next one is filled
+    for (uint16_t y = top; y <= bottom; ++y) {
+        const uint16_t *source          = &surface->buffer[y * surface->base.panel_width + left];
+        uint32_t        pixel_remaining = right - left + 1;
+        while (pixel_remaining > 0) {
+            uint32_t pixel_this_loop = total_pixel_count - pixel_counter;
+            if (pixel_this_loop > pixel_remaining) {
+                pixel_this_loop = pixel_remaining;
+            }
+            memcpy(&target_buffer[pixel_counter], source, pixel_this_loop * sizeof(uint16_t));
+            source += pixel_this_loop;
+            pixel_counter += pixel_this_loop;
+            pixel_remaining -= pixel_this_loop;
 
             // If we've accumulated enough data, send it
             if (pixel_counter == total_pixel_count) {
-                ok = qp_pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
-                if (!ok) {
+                if (!display_driver->driver_vtable->pixdata(display, target_buffer, pixel_counter)) {
                     return false;
                 }
                 // Reset the counter
@@ -266,10 +255,67 @@ bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display,
 
     // If there's any leftover data, send it
     if (pixel_counter > 0) {
-        ok = qp_pixdata(display, qp_internal_global_pixdata_buffer, pixel_counter);
-        if (!ok) {
-            return false;
+        return display_driver->driver_vtable->pixdata(display, target_buffer, pixel_counter);
+    }
+    return true;
+}
+
+bool qp_rgb565_surface_draw(painter_device_t surface, painter_device_t display, uint16_t x, uint16_t y) {
+    struct painter_driver_t *        surface_driver = (struct painter_driver_t *)surface;
+    rgb565_surface_painter_device_t *surface_handle = (rgb565_surface_painter_device_t *)surface_driver;
+    struct painter_driver_t *        display_driver = (struct painter_driver_t *)display;
+
+    // If we're not dirty... we're done.
+    if (!surface_handle->is_dirty) {
+        return true;
+    }
+
+    // Keep comms open for the whole draw, so that transfers aren't waited upon between each of the dirty areas
+    if (!qp_comms_start(display)) {
+        return false;
+    }
+
+    bool     ok        = true;
+    uint16_t width     = surface_driver->panel_width;
+    uint16_t height    = surface_driver->panel_height;
+    uint16_t tile_rows = (height + surface_handle->tile_height - 1) / surface_handle->tile_height;
+    uint16_t first_row = 0;
+    while (ok && first_row < tile_rows) {
+        // Consecutive rows of tiles with the same dirty columns can be sent together
+        uint32_t dirty    = surface_handle->dirty_tiles[first_row];
+        uint16_t last_row = first_row;
+        while (dirty && last_row + 1 < tile_rows && surface_handle->dirty_tiles[last_row + 1] == dirty) {
+            ++last_row;
         }
+
+        uint16_t top    = first_row * surface_handle->tile_height;
+        uint16_t bottom = QP_MIN((last_row + 1) * surface_handle->tile_height, height) - 1;
+        while (ok && dirty) {
+            // Find the next horizontal run of dirty tiles
+            uint8_t first_col = __builtin_ctzl(dirty);
+            uint8_t last_col  = first_col;
+            while (last_col < 31 && (dirty & (1UL << (last_col + 1)))) {
+                ++last_col;
+            }
+            for (uint8_t col = first_col; col <= last_col; ++col) {
+                dirty &= ~(1UL << col);
+            }
+
+            // Set the target drawing area, then send the pixel data for it
+            uint16_t left  = first_col * surface_handle->tile_width;
+            uint16_t right = QP_MIN((last_col + 1) * surface_handle->tile_width, width) - 1;
+            ok             = display_driver->driver_vtable->viewport(display, x + left, y + top, x + right, y + bottom);
+            if (ok) {
+                ok = stream_region(surface_handle, display, left, top, right, bottom);
+            }
+        }
+
+        first_row = last_row + 1;
+    }
+
+    qp_comms_stop(display);
+    if (!ok) {
+        return false;
     }
 
     // Clear the dirty info for the surface
@@ -13,6 +13,23 @@
 #    define RGB565_SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef RGB565_SURFACE_TILE_SIZE
+/**
+ * @def This controls the size (in pixels, both width and height) of the tiles used to track which areas of a surface
+ *      have been drawn to. Smaller tiles transfer less unchanged data to the display, at the cost of more viewport
+ *      commands. Surfaces wider than 32 tiles, or taller than RGB565_SURFACE_MAX_TILE_ROWS tiles, use larger tiles.
+ */
+#    define RGB565_SURFACE_TILE_SIZE 16
+#endif
+
+#ifndef RGB565_SURFACE_MAX_TILE_ROWS
+/**
+ * @def This controls the maximum number of rows of tiles in a surface, taller surfaces use taller tiles. Each row of
+ *      tiles requires 4 bytes of RAM per surface.
+ */
+#    define RGB565_SURFACE_MAX_TILE_ROWS 32
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -28,6 +28,13 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_MATRIX_PUSH
+// target sends a frame without waiting for the initiator to poll it
+bool soft_serial_push(const split_slave_matrix_push_t *push);
+// initiator hands every frame pushed by the target so far to transport_push_received()
+void soft_serial_receive_pushes(void);
+#endif
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
@@ -0,0 +1,242 @@
+"""Python program to make leader_data.h.
+
+This program reads from a leader dictionary file and generates a C header
+"leader_data.h" with the sequences compiled into a trie, which the leader key
+feature walks as each key is pressed. Run it as:
+
+$ qmk generate-leader-data leader_dictionary.txt
+
+Each line of the dictionary file defines one sequence and the keycode it sends
+with the syntax "sequence -> keycode". Keys of the sequence are separated by
+whitespace, and are either basic keycode names, or runs of the characters a-z
+and 0-9, which are typed one key each. The keycode is any C expression, and is
+copied to the generated header as-is. Blank lines or lines starting with '#'
+are ignored. Example:
+
+  e          -> LCTL(LSFT(KC_T))
+  e d        -> LGUI(KC_R)
+  gh         -> KC_HOME
+  KC_SPC KC_SPC -> KC_ESC
+
+For full documentation, see QMK Docs
+"""
+
+import re
+import sys
+import textwrap
+from typing import Any, Dict, Iterator, List, Tuple
+
+from milc import cli
+
+import qmk.path
+from qmk.keyboard import keyboard_completer, keyboard_folder
+from qmk.keycodes import load_spec
+from qmk.keymap import keymap_completer, locate_keymap
+
+KC_A = 0x04
+KC_1 = 0x1E
+KC_0 = 0x27
+
+LEADER_NODE_TERMINAL = 0x01
+
+SEQUENCE_CHARS = dict([(chr(c), c + KC_A - ord('a')) for c in range(ord('a'), ord('z') + 1)] + [(chr(c), c + KC_1 - ord('1')) for c in range(ord('1'), ord('9') + 1)] + [('0', KC_0)])
+
+
+def basic_keycodes() -> Dict[str, int]:
+    """Builds a lookup of the names and aliases of all basic keycodes, which are the only ones a sequence may contain.
+    """
+    keycodes = {}
+    for value, keycode in load_spec('latest')['keycodes'].items():
+        value = int(value, 16)
+        if 0 < value <= 0xFF:
+            for name in [keycode['key']] + keycode.get('aliases', []):
+                keycodes[name] = value
+    return keycodes
+
+
+def parse_file_lines(file_name: str) -> Iterator[Tuple[int, str, str]]:
+    """Parses lines read from `file_name` into sequence-keycode pairs."""
+
+    line_number = 0
+    for line in open(file_name, 'rt'):
+        line_number += 1
+        line = line.strip()
+        if line and line[0] != '#':
+            # Parse syntax "sequence -> keycode", using strip to ignore indenting.
+            tokens = [token.strip() for token in line.split('->', 1)]
+            if len(tokens) != 2 or not tokens[0] or not tokens[1]:
+                cli.log.error('{fg_red}Error:%d:{fg_reset} Invalid syntax: "{fg_cyan}%s{fg_reset}"', line_number, line)
+                sys.exit(1)
+
+            yield line_number, tokens[0], tokens[1]
+
+
+def parse_sequence(sequence: str, line_number: int, keycodes: Dict[str, int]) -> Tuple[int, ...]:
+    """Converts the keys of a sequence into basic keycodes."""
+
+    keys = []
+    for token in sequence.split():
+        if token in keycodes:
+            keys.append(keycodes[token])
+        elif re.fullmatch('[a-z0-9]+', token):
+            keys += [SEQUENCE_CHARS[c] for c in token]
+        else:
+            cli.log.error('{fg_red}Error:%d:{fg_reset} "{fg_cyan}%s{fg_reset}" is neither a basic keycode nor made of the characters a-z and 0-9.', line_number, token)
+            sys.exit(1)
+    return tuple(keys)
+
+
+def parse_file(file_name: str) -> List[Tuple[Tuple[int, ...], str, str]]:
+    """Parses the leader dictionary file.
+
+    Args:
+      file_name: String, path of the leader dictionary.
+    Returns:
+      List of (keys, sequence, keycode) tuples.
+    """
+    keycodes = basic_keycodes()
+
+    entries = []
+    sequences = {}
+    for line_number, sequence, keycode in parse_file_lines(file_name):
+        keys = parse_sequence(sequence, line_number, keycodes)
+        if keys in sequences:
+            cli.log.error('{fg_red}Error:%d:{fg_reset} Sequence "{fg_cyan}%s{fg_reset}" is already defined on line %d.', line_number, sequence, sequences[keys])
+            sys.exit(1)
+
+        sequences[keys] = line_number
+        entries.append((keys, sequence, keycode))
+
+    for keys, sequence, _ in entries:
+        if any(len(other) > len(keys) and other[:len(keys)] == keys for other in sequences):
+            cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Sequence "{fg_cyan}%s{fg_reset}" is the start of a longer sequence, so it only fires once the leader timeout expires.', sequences[keys], sequence)
+
+    return entries
+
+
+def make_trie(entries: List[Tuple[Tuple[int, ...], str, str]]) -> Dict[Any, Any]:
+    """Makes a trie from the sequences, with the index of the entry stored at the node where its sequence ends.
+
+    Args:
+      entries: List of (keys, sequence, keycode) tuples.
+    Returns:
+      Dict of dicts, representing the trie.
+    """
+    trie = {}
+    for index, (keys, _, _) in enumerate(entries):
+        node = trie
+        for key in keys:
+            node = node.setdefault(key, {})
+        node['LEAF'] = index
+
+    return trie
+
+
+def serialize_trie(trie: Dict[Any, Any]) -> List[int]:
+    """Serializes the trie in a form readable by the C code.
+
+    Each node starts with a flags byte. Terminal nodes follow it with the index of their keycode, as two bytes. Then
+    comes the number of children, and for each child its keycode and the offset of its node, as two bytes. Nodes are
+    laid out in depth first order, so the root node is at offset 0.
+
+    Args:
+      trie: Dict of dicts.
+    Returns:
+      List of ints in the range 0-255.
+    """
+    table = []
+
+    def traverse(trie_node):
+        entry = {'node': trie_node, 'children': [], 'byte_offset': 0}
+        table.append(entry)
+        entry['children'] = [(key, traverse(trie_node[key])) for key in sorted(k for k in trie_node if k != 'LEAF')]
+        return entry
+
+    traverse(trie)
+
+    def serialize(e: Dict[str, Any]) -> List[int]:
+        data = []
+        if 'LEAF' in e['node']:
+            data += [LEADER_NODE_TERMINAL] + encode_word(e['node']['LEAF'])
+        else:
+            data += [0]
+        data += [len(e['children'])]
+        for key, child in e['children']:
+            data += [key] + encode_word(child['byte_offset'])
+        return data
+
+    byte_offset = 0
+    for e in table:  # To encode links, first compute byte offset of each entry.
+        e['byte_offset'] = byte_offset
+        byte_offset += len(serialize(e))
+
+    # 0xffff is reserved for LEADER_NODE_NONE, so every node must start below it
+    if byte_offset >= 0xffff:
+        cli.log.error('{fg_red}Error:{fg_reset} The leader dictionary is too large, a node link exceeds 64KB limit. Try reducing the leader dictionary to fewer entries.')
+        sys.exit(1)
+
+    return [b for e in table for b in serialize(e)]  # Serialize final table.
+
+
+def encode_word(value: int) -> List[int]:
+    """Encodes a node link or keycode index as two bytes."""
+    return [value & 255, value >> 8]
+
+
+def write_generated_code(entries: List[Tuple[Tuple[int, ...], str, str]], data: List[int], file_name: str) -> None:
+    """Writes the leader dictionary as generated C code to `file_name`.
+
+    Args:
+      entries: List of (keys, sequence, keycode) tuples.
+      data: List of ints in 0-255, the serialized trie.
+      file_name: String, path of the output C file.
+    """
+    assert all(0 <= b <= 255 for b in data)
+
+    max_sequence = max(len(sequence) for _, sequence, _ in entries)
+    generated_code = ''.join([
+        '// Generated code.\n\n', f'// Leader dictionary ({len(entries)} entries):\n', ''.join(f'//   {sequence:<{max_sequence}} -> {keycode}\n' for _, sequence, keycode in entries),
+        f'\n#define LEADER_DICTIONARY_SIZE {len(data)}\n', f'#define LEADER_DICTIONARY_KEYCODES {len(entries)}\n\n',
+        textwrap.fill('static const uint8_t leader_data[LEADER_DICTIONARY_SIZE] PROGMEM = {%s};' % (', '.join(map(str, data))), width=120, subsequent_indent='    '), '\n\n',
+        'static const uint16_t leader_keycodes[LEADER_DICTIONARY_KEYCODES] PROGMEM = {\n', ''.join(f'    {keycode},\n' for _, _, keycode in entries), '};\n'
+    ])
+
+    with open(file_name, 'wt') as f:
+        f.write(generated_code)
+
+
+@cli.argument('filename', default='leader_dictionary.txt', help='The leader dictionary file')
+@cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for. Ignored when a configurator export is supplied.')
+@cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a configurator export is supplied.')
+@cli.argument('-o', '--output', arg_only=True, type=qmk.path.normpath, help='File to write to')
+@cli.subcommand('Generate the leader data file from a dictionary file.')
+def generate_leader_data(cli):
+    entries = parse_file(cli.args.filename)
+    if not entries:
+        cli.log.error('{fg_red}Error:{fg_reset} The leader dictionary is empty.')
+        return False
+
+    trie = make_trie(entries)
+    data = serialize_trie(trie)
+    # Environment processing
+    if cli.args.output == '-':
+        cli.args.output = None
+
+    if cli.args.output:
+        cli.args.output.parent.mkdir(parents=True, exist_ok=True)
+        cli.log.info('Creating leader dictionary at {fg_cyan}%s', cli.args.output)
+        write_generated_code(entries, data, cli.args.output)
+
+    else:
+        current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_leader_data.keyboard
+        current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_leader_data.keymap
+
+        if current_keyboard and current_keymap:
+            filename = locate_keymap(current_keyboard, current_keymap).parent / 'leader_data.h'
+            cli.log.info('Creating leader dictionary at {fg_cyan}%s', filename)
+            write_generated_code(entries, data, filename)
+
+        else:
+            write_generated_code(entries, data, 'leader_data.h')
+
+    cli.log.info('Processed %d leader sequences to table with %d bytes.', len(entries), len(data))
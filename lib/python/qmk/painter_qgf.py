@@ -339,6 +339,13 @@ def _save(im, fp, filename):
                     use_raw_this_frame = delta_use_raw_this_frame
                     image_data = delta_image_data
                     use_delta_this_frame = True
+            else:
+                # Nothing changed since the last frame, so emit an empty delta frame -- nothing needs drawing at all
+                location = (0, 0)
+                size = (0, 0)
+                use_raw_this_frame = True
+                image_data = []
+                use_delta_this_frame = True
 
         # Write out the frame descriptor
         frame_offsets.frame_offsets[idx] = fp.tell()
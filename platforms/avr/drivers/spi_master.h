@@ -20,6 +20,10 @@
 
 #include "gpio.h"
 
+#ifdef SPI_ASYNC_ENABLE
+#    error "SPI_ASYNC_ENABLE is only supported on ChibiOS"
+#endif
+
 typedef int16_t spi_status_t;
 
 // Hardware SS pin is defined in the header so that user code can refer to it
@@ -123,11 +123,173 @@ static i2c_status_t i2c_epilogue(const msg_t status) {
     // From ChibiOS HAL: "After a timeout the driver must be stopped and
     // restarted because the bus is in an uncertain state." We also issue that
     // hard stop in case of any error.
-    i2c_stop();
+    i2cStop(&I2C_DRIVER);
 
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
 
+#ifdef I2C_ASYNC_ENABLE
+#    ifndef I2C_ASYNC_QUEUE_LENGTH
+#        define I2C_ASYNC_QUEUE_LENGTH 16
+#    endif
+#    ifndef I2C_ASYNC_BUFFER_SIZE
+#        define I2C_ASYNC_BUFFER_SIZE 65
+#    endif
+#    if I2C_ASYNC_QUEUE_LENGTH > 128 || (I2C_ASYNC_QUEUE_LENGTH & (I2C_ASYNC_QUEUE_LENGTH - 1)) != 0
+#        error I2C_ASYNC_QUEUE_LENGTH must be a power of two no larger than 128
+#    endif
+
+typedef struct {
+    uint8_t              address;
+    uint16_t             length;
+    uint16_t             timeout;
+    i2c_async_callback_t callback;
+    void*                context;
+    i2c_status_t         status;
+    uint8_t              data[I2C_ASYNC_BUFFER_SIZE];
+} i2c_async_job_t;
+
+// Jobs are copied into the queue, so callers are free to reuse their buffers as soon as a job is queued.
+// The counters wrap around, slots are indexed by counter % I2C_ASYNC_QUEUE_LENGTH.
+static i2c_async_job_t    i2c_async_queue[I2C_ASYNC_QUEUE_LENGTH];
+static uint8_t            i2c_async_queued     = 0; // Only written by the main thread
+static volatile uint8_t   i2c_async_completed  = 0; // Only written by the I2C thread
+static uint8_t            i2c_async_dispatched = 0; // Only written by the main thread
+static semaphore_t        i2c_async_pending;
+static binary_semaphore_t i2c_async_done;
+
+/**
+ * @brief Performs the queued jobs in order. The thread sleeps while the
+ * transfer is carried out by the interrupt/DMA driven ChibiOS I2C driver,
+ * so the main loop keeps running in the meantime.
+ */
+static THD_WORKING_AREA(waI2CAsyncThread, 256);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&i2c_async_pending);
+
+        i2c_async_job_t* job = &i2c_async_queue[i2c_async_completed % I2C_ASYNC_QUEUE_LENGTH];
+        i2cStart(&I2C_DRIVER, &i2cconfig);
+        msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (job->address >> 1), job->data, job->length, 0, 0, TIME_MS2I(job->timeout));
+        job->status  = i2c_epilogue(status);
+
+        i2c_async_completed++;
+        chBSemSignal(&i2c_async_done);
+    }
+}
+
+static void i2c_async_start(void) {
+    static bool is_started = false;
+    if (!is_started) {
+        is_started = true;
+
+        chSemObjectInit(&i2c_async_pending, 0);
+        chBSemObjectInit(&i2c_async_done, false);
+        chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), NORMALPRIO + 1, I2CAsyncThread, NULL);
+    }
+}
+
+static inline bool i2c_async_full(void) {
+    return (uint8_t)(i2c_async_queued - i2c_async_dispatched) >= I2C_ASYNC_QUEUE_LENGTH;
+}
+
+static i2c_async_job_t* i2c_async_acquire(void) {
+    i2c_async_start();
+
+    // Slots only become free once their callback was dispatched
+    while (true) {
+        i2c_async_task();
+        if (!i2c_async_full()) {
+            break;
+        }
+        chBSemWait(&i2c_async_done);
+    }
+
+    return &i2c_async_queue[i2c_async_queued % I2C_ASYNC_QUEUE_LENGTH];
+}
+
+static void i2c_async_submit(i2c_async_job_t* job, uint8_t address, uint16_t timeout, i2c_async_callback_t callback, void* context) {
+    job->address  = address;
+    job->timeout  = timeout;
+    job->callback = callback;
+    job->context  = context;
+
+    i2c_async_queued++;
+    chSemSignal(&i2c_async_pending);
+}
+
+void i2c_async_task(void) {
+    while (i2c_async_dispatched != i2c_async_completed) {
+        // Release the slot before the callback, which may queue further jobs
+        i2c_async_job_t*     job      = &i2c_async_queue[i2c_async_dispatched % I2C_ASYNC_QUEUE_LENGTH];
+        i2c_async_callback_t callback = job->callback;
+        i2c_status_t         status   = job->status;
+        void*                context  = job->context;
+        i2c_async_dispatched++;
+
+        if (callback) {
+            callback(status, context);
+        }
+    }
+}
+
+bool i2c_async_busy(void) {
+    return i2c_async_dispatched != i2c_async_queued;
+}
+
+void i2c_async_flush(void) {
+    while (true) {
+        i2c_async_task();
+        if (!i2c_async_busy()) {
+            break;
+        }
+        chBSemWait(&i2c_async_done);
+    }
+}
+
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context) {
+    if (length > I2C_ASYNC_BUFFER_SIZE) {
+        // Too large to be queued, fall back to a blocking transfer which still happens in order
+        i2c_status_t status = i2c_transmit(address, data, length, timeout);
+        if (callback) {
+            callback(status, context);
+        }
+        return status;
+    }
+
+    i2c_async_job_t* job = i2c_async_acquire();
+    memcpy(job->data, data, length);
+    job->length = length;
+    i2c_async_submit(job, address, timeout, callback, context);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context) {
+    if (length + 1 > I2C_ASYNC_BUFFER_SIZE) {
+        i2c_status_t status = i2c_writeReg(devaddr, regaddr, data, length, timeout);
+        if (callback) {
+            callback(status, context);
+        }
+        return status;
+    }
+
+    i2c_async_job_t* job = i2c_async_acquire();
+    job->data[0]         = regaddr;
+    memcpy(&job->data[1], data, length);
+    job->length = length + 1;
+    i2c_async_submit(job, devaddr, timeout, callback, context);
+    return I2C_STATUS_SUCCESS;
+}
+
+// Blocking transfers wait for the queued jobs first, so transfers stay in order and never share the bus
+#    define I2C_ASYNC_FLUSH() i2c_async_flush()
+#else
+#    define I2C_ASYNC_FLUSH()
+#endif
+
 __attribute__((weak)) void i2c_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -149,12 +311,14 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_start(uint8_t address) {
+    I2C_ASYNC_FLUSH();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     return I2C_STATUS_SUCCESS;
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    I2C_ASYNC_FLUSH();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
@@ -162,6 +326,7 @@ i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length,
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    I2C_ASYNC_FLUSH();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
@@ -169,6 +334,7 @@ i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    I2C_ASYNC_FLUSH();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -183,6 +349,7 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
 }
 
 i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    I2C_ASYNC_FLUSH();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -198,6 +365,7 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    I2C_ASYNC_FLUSH();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
@@ -205,6 +373,7 @@ i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16
 }
 
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    I2C_ASYNC_FLUSH();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
@@ -213,5 +382,6 @@ i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uin
 }
 
 void i2c_stop(void) {
+    I2C_ASYNC_FLUSH();
     i2cStop(&I2C_DRIVER);
 }
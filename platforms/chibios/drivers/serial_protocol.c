@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <ch.h>
+#include <string.h>
 
 #include "quantum.h"
 #include "serial.h"
@@ -12,6 +13,47 @@
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
+#if defined(SPLIT_MATRIX_PUSH)
+/* Starts a frame pushed by the slave, distinct from any handshake token. */
+#    define SERIAL_PUSH_MARKER 0x80
+#endif
+
+#if defined(SPLIT_TRANSPORT_COALESCE)
+/**
+ * @brief Send a transaction buffer. Coalesced frames only carry the regions
+ * that changed, so only as much of them as their header states is sent.
+ */
+static inline bool send_buffer(uint8_t transaction_id, const uint8_t* source, size_t size) {
+    if (transaction_id == EXCHANGE_FRAME) {
+        size = split_frame_size((const split_frame_t*)source);
+    }
+    return serial_transport_send(source, size);
+}
+
+/**
+ * @brief Receive a transaction buffer, coalesced frames up to the length
+ * their header states.
+ */
+static inline bool receive_buffer(uint8_t transaction_id, uint8_t* destination, size_t size) {
+    if (transaction_id != EXCHANGE_FRAME) {
+        return serial_transport_receive(destination, size);
+    }
+
+    if (unlikely(!serial_transport_receive(destination, SPLIT_FRAME_HEADER_SIZE))) {
+        return false;
+    }
+    size_t frame_size = split_frame_size((const split_frame_t*)destination);
+    if (unlikely(frame_size > size)) {
+        return false;
+    }
+    /* A frame without any changed regions is just its header. */
+    return frame_size == SPLIT_FRAME_HEADER_SIZE || serial_transport_receive(destination + SPLIT_FRAME_HEADER_SIZE, frame_size - SPLIT_FRAME_HEADER_SIZE);
+}
+#else
+#    define send_buffer(transaction_id, source, size) serial_transport_send(source, size)
+#    define receive_buffer(transaction_id, destination, size) serial_transport_receive(destination, size)
+#endif
+
 /**
  * @brief This thread runs on the slave and responds to transactions initiated
  * by the master.
@@ -68,14 +110,14 @@ static inline bool react_to_transaction(void) {
 
     /* Send back the handshake which is XORed as a simple checksum,
      to signal that the slave is ready to receive possible transaction buffers  */
-    transaction_id ^= NUM_TOTAL_TRANSACTIONS;
-    if (unlikely(!serial_transport_send(&transaction_id, sizeof(transaction_id)))) {
+    uint8_t transaction_id_shake = transaction_id ^ NUM_TOTAL_TRANSACTIONS;
+    if (unlikely(!serial_transport_send(&transaction_id_shake, sizeof(transaction_id_shake)))) {
         return false;
     }
 
     /* Receive transaction buffer from the master. If this transaction requires it.*/
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!receive_buffer(transaction_id, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
             return false;
         }
     }
@@ -87,7 +129,7 @@ static inline bool react_to_transaction(void) {
 
     /* Send transaction buffer to the master. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        if (unlikely(!send_buffer(transaction_id, split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
             return false;
         }
     }
@@ -95,6 +137,70 @@ static inline bool react_to_transaction(void) {
     return true;
 }
 
+#if defined(SPLIT_MATRIX_PUSH)
+
+/**
+ * @brief Push a frame from the slave half to the master half, without waiting
+ * for a transaction. The shared memory lock keeps it from interleaving with
+ * the response to a transaction.
+ */
+bool soft_serial_push(const split_slave_matrix_push_t* push) {
+    split_shared_memory_lock_autounlock();
+
+    const uint8_t marker = SERIAL_PUSH_MARKER;
+    return serial_transport_send(&marker, sizeof(marker)) && serial_transport_send((const uint8_t*)push, sizeof(*push));
+}
+
+/**
+ * @brief Receive the remainder of a pushed frame, after its marker, and queue
+ * it for the master.
+ */
+static inline bool receive_push(void) {
+    split_slave_matrix_push_t push;
+    if (unlikely(!serial_transport_receive((uint8_t*)&push, sizeof(push)))) {
+        serial_dprintf("SPLIT: receiving pushed frame failed\n");
+        return false;
+    }
+    transport_push_received(&push);
+    return true;
+}
+
+/**
+ * @brief Collect the frames pushed since the last transaction. Anything else
+ * in the receive queue is left over from failed transactions and discarded.
+ */
+void soft_serial_receive_pushes(void) {
+    uint8_t marker;
+    while (serial_transport_receive_nonblocking(&marker, sizeof(marker))) {
+        if (marker != SERIAL_PUSH_MARKER || !receive_push()) {
+            serial_transport_driver_clear();
+            return;
+        }
+    }
+}
+
+#endif
+
+/**
+ * @brief Receive the handshake of a transaction. A frame the slave pushed just
+ * before it picked up the transaction may arrive first.
+ */
+static inline bool receive_handshake(uint8_t* transaction_id_shake) {
+#if defined(SPLIT_MATRIX_PUSH)
+    while (serial_transport_receive(transaction_id_shake, sizeof(*transaction_id_shake))) {
+        if (*transaction_id_shake != SERIAL_PUSH_MARKER) {
+            return true;
+        }
+        if (!receive_push()) {
+            return false;
+        }
+    }
+    return false;
+#else
+    return serial_transport_receive(transaction_id_shake, sizeof(*transaction_id_shake));
+#endif
+}
+
 /**
  * @brief Start transaction from the master half to the slave half.
  *
@@ -102,9 +208,14 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#if defined(SPLIT_MATRIX_PUSH)
+    /* Keep the frames pushed in the meantime, but clear anything else. */
+    soft_serial_receive_pushes();
+#else
     /* Clear the receive queue, to start with a clean slate.
      * Parts of failed transactions or spurious bytes could still be in it. */
     serial_transport_driver_clear();
+#endif
 
     return initiate_transaction((uint8_t)index);
 }
@@ -135,14 +246,14 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
      *   - due to the half duplex limitations on return codes, we always have to read *something*.
      *   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready.
      */
-    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
+    if (unlikely(!receive_handshake(&transaction_id_shake) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
         serial_dprintf("SPLIT: receiving handshake failed\n");
         return false;
     }
 
     /* Send transaction buffer to the slave. If this transaction requires it. */
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!send_buffer(transaction_id, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
             serial_dprintf("SPLIT: sending buffer failed\n");
             return false;
         }
@@ -150,7 +261,7 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     /* Receive transaction buffer from the slave. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        if (unlikely(!receive_buffer(transaction_id, split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
             serial_dprintf("SPLIT: receiving buffer failed\n");
             return false;
         }
@@ -47,3 +47,11 @@ bool __attribute__((nonnull, hot)) serial_transport_receive_blocking(uint8_t* de
  * @return false Send failed, e.g. by timeout or bit errors.
  */
 bool __attribute__((nonnull, hot)) serial_transport_send(const uint8_t* source, const size_t size);
+
+/**
+ * @brief Receive of size * bytes, only if they are already available.
+ *
+ * @return true Receive success.
+ * @return false Not enough data available, or receive failed.
+ */
+bool __attribute__((nonnull, hot)) serial_transport_receive_nonblocking(uint8_t* destination, const size_t size);
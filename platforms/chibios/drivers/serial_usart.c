@@ -163,6 +163,13 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+#if defined(SERIAL_USART_FULL_DUPLEX)
+inline bool serial_transport_receive_nonblocking(uint8_t* destination, const size_t size) {
+    bool success = (size_t)chnReadTimeout(serial_driver, destination, size, TIME_IMMEDIATE) == size;
+    return success;
+}
+#endif
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
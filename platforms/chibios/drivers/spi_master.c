@@ -20,6 +20,10 @@
 
 static pin_t currentSlavePin = NO_PIN;
 
+#ifdef SPI_ASYNC_ENABLE
+static bool async_active = false;
+#endif
+
 #if defined(K20x) || defined(KL2x) || defined(RP2040)
 static SPIConfig spiConfig = {NULL, 0, 0, 0};
 #else
@@ -258,7 +262,33 @@ bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     return true;
 }
 
+#ifdef SPI_ASYNC_ENABLE
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    spi_async_wait();
+    async_active = true;
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+void spi_async_wait(void) {
+    if (!async_active) {
+        return;
+    }
+
+    // Sleep until the DMA completion interrupt, in the same way that the blocking API does
+    osalSysLock();
+    if (SPI_DRIVER.state == SPI_ACTIVE) {
+        osalThreadSuspendS(&SPI_DRIVER.thread);
+    }
+    osalSysUnlock();
+    async_active = false;
+}
+#else
+#    define spi_async_wait()
+#endif
+
 spi_status_t spi_write(uint8_t data) {
+    spi_async_wait();
     uint8_t rxData;
     spiExchange(&SPI_DRIVER, 1, &data, &rxData);
 
@@ -266,6 +296,7 @@ spi_status_t spi_write(uint8_t data) {
 }
 
 spi_status_t spi_read(void) {
+    spi_async_wait();
     uint8_t data = 0;
     spiReceive(&SPI_DRIVER, 1, &data);
 
@@ -273,17 +304,20 @@ spi_status_t spi_read(void) {
 }
 
 spi_status_t spi_transmit(const uint8_t *data, uint16_t length) {
+    spi_async_wait();
     spiSend(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 spi_status_t spi_receive(uint8_t *data, uint16_t length) {
+    spi_async_wait();
     spiReceive(&SPI_DRIVER, length, data);
     return SPI_STATUS_SUCCESS;
 }
 
 void spi_stop(void) {
     if (currentSlavePin != NO_PIN) {
+        spi_async_wait();
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         currentSlavePin = NO_PIN;
@@ -88,6 +88,13 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
 void spi_stop(void);
+
+#ifdef SPI_ASYNC_ENABLE
+/* Starts a DMA transmission and returns immediately, after waiting for any previous one to complete.
+ * The data must remain unchanged until the transfer has completed. All other functions wait for completion first. */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length);
+void         spi_async_wait(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
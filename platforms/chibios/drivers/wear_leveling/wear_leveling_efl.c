@@ -37,6 +37,17 @@ static inline uint32_t detect_flash_size(void) {
 #endif
 }
 
+// Whether the address, relative to the start of the backing store, is the start or end of one of its sectors
+static bool is_sector_boundary(uint32_t address) {
+    for (int i = 0; i < sector_count; ++i) {
+        uint32_t sector_start = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        if (address == sector_start || address == sector_start + flashGetSectorSize(flash, first_sector + i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool backing_store_init(void) {
     bs_dprintf("Init\n");
     flash = (BaseFlash *)&EFLD1;
@@ -84,6 +95,15 @@ bool backing_store_init(void) {
 
 #endif // defined(WEAR_LEVELING_EFL_FIRST_SECTOR)
 
+#if defined(WEAR_LEVELING_DOUBLE_BANK)
+    // Erasing part of a sector would take the rest of it along, which may belong to the active bank
+    for (uint32_t address = 0; address <= (WEAR_LEVELING_BACKING_SIZE); address += (BACKING_STORE_ERASE_SIZE)) {
+        if (!is_sector_boundary(address)) {
+            chSysHalt("Double-bank wear_leveling requires the erase size to be a multiple of the sector size");
+        }
+    }
+#endif // defined(WEAR_LEVELING_DOUBLE_BANK)
+
     return true;
 }
 
@@ -117,6 +137,44 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+#ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#endif
+
+    // Refuse to erase anything outside of the requested range
+    if (!is_sector_boundary(address) || !is_sector_boundary(address + length)) {
+        bs_dprintf("Range erase not aligned to sectors\n");
+        return false;
+    }
+
+    bool          ret = true;
+    flash_error_t status;
+    for (int i = 0; i < sector_count; ++i) {
+        // Skip any sectors outside of the requested range
+        uint32_t sector_start = flashGetSectorOffset(flash, first_sector + i) - base_offset;
+        uint32_t sector_end   = sector_start + flashGetSectorSize(flash, first_sector + i);
+        if (sector_end <= address || sector_start >= address + length) {
+            continue;
+        }
+
+        // Kick off the sector erase
+        status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        // Wait for the erase to complete
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+
+    bs_dprintf("Backing store range erase took %ldms to complete\n", ((long)(timer_read32() - start)));
+    return ret;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
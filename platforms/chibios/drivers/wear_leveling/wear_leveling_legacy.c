@@ -7,6 +7,10 @@
 #include "wear_leveling_internal.h"
 #include "legacy_flash_ops.h"
 
+#if defined(WEAR_LEVELING_DOUBLE_BANK)
+_Static_assert((BACKING_STORE_ERASE_SIZE) % (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE) == 0, "Double-bank wear_leveling erase size must be a multiple of the flash page size");
+#endif // defined(WEAR_LEVELING_DOUBLE_BANK)
+
 bool backing_store_init(void) {
     bs_dprintf("Init\n");
     return true;
@@ -36,6 +40,24 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+#ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#endif
+
+    bool         ret = true;
+    FLASH_Status status;
+    for (uint32_t offset = address; offset < address + length; offset += (WEAR_LEVELING_LEGACY_EMULATION_PAGE_SIZE)) {
+        status = FLASH_ErasePage(WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS + offset);
+        if (status != FLASH_COMPLETE) {
+            ret = false;
+        }
+    }
+
+    bs_dprintf("Backing store range erase took %ldms to complete\n", ((long)(timer_read32() - start)));
+    return ret;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = ((WEAR_LEVELING_LEGACY_EMULATION_BASE_PAGE_ADDRESS) + address);
     bs_dprintf("Write ");
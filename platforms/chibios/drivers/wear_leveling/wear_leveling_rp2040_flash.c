@@ -21,6 +21,10 @@
 #    define WEAR_LEVELING_RP2040_FLASH_BULK_COUNT 64
 #endif // WEAR_LEVELING_RP2040_FLASH_BULK_COUNT
 
+#if defined(WEAR_LEVELING_DOUBLE_BANK)
+_Static_assert((BACKING_STORE_ERASE_SIZE) % (FLASH_SECTOR_SIZE) == 0, "Double-bank wear_leveling erase size must be a multiple of the flash sector size");
+#endif // defined(WEAR_LEVELING_DOUBLE_BANK)
+
 #define FLASHCMD_PAGE_PROGRAM 0x02
 #define FLASHCMD_READ_STATUS 0x05
 #define FLASHCMD_WRITE_ENABLE 0x06
@@ -187,6 +191,19 @@ bool backing_store_erase(void) {
     return true;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+#ifdef WEAR_LEVELING_DEBUG_OUTPUT
+    uint32_t start = timer_read32();
+#endif
+
+    interrupts = save_and_disable_interrupts();
+    flash_range_erase((WEAR_LEVELING_RP2040_FLASH_BASE) + address, length);
+    restore_interrupts(interrupts);
+
+    bs_dprintf("Backing store range erase took %ldms to complete\n", ((long)(timer_read32() - start)));
+    return true;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
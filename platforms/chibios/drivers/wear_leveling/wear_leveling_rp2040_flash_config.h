@@ -11,6 +11,11 @@
 #    define BACKING_STORE_WRITE_SIZE 2
 #endif
 
+// Erase a flash sector at a time with WEAR_LEVELING_DOUBLE_BANK
+#ifndef BACKING_STORE_ERASE_SIZE
+#    define BACKING_STORE_ERASE_SIZE (FLASH_SECTOR_SIZE)
+#endif
+
 // 64kB backing space allocated
 #ifndef WEAR_LEVELING_BACKING_SIZE
 #    define WEAR_LEVELING_BACKING_SIZE 8192
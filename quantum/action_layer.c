@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef DEBUG_ACTION
 #    include "debug.h"
@@ -9,6 +10,7 @@
 
 #include "keyboard.h"
 #include "keymap.h"
+#include "matrix.h"
 #include "action.h"
 #include "util.h"
 #include "action_layer.h"
@@ -322,18 +324,17 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Find layer
  *
- * Gets the layer based on key info
+ * Gets the topmost non-transparent layer of the key, searching downwards from `top`
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_find_for_key(keypos_t key, layer_state_t layers, int8_t top) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
-    layer_state_t layers = layer_state | default_layer_state;
     /* check top layer first */
-    for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
+    for (int8_t i = top; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
             action = action_for_key(i, key);
             if (action.code != ACTION_TRANSPARENT) {
@@ -343,6 +344,79 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if !defined(NO_ACTION_LAYER) && defined(LAYER_LOOKUP_CACHE)
+/** \brief layer lookup cache
+ *
+ * Topmost non-transparent layer of every key, valid for the layers in layer_lookup_cache_state
+ * where the key's bit is set in layer_lookup_cache_valid
+ */
+static uint8_t       layer_lookup_cache[MATRIX_ROWS][MATRIX_COLS];
+static matrix_row_t  layer_lookup_cache_valid[MATRIX_ROWS] = {0};
+static layer_state_t layer_lookup_cache_state              = 0;
+
+/** \brief Layer lookup cache invalidate
+ *
+ * Forces every key to be resolved again, call after the keymap was changed
+ */
+void layer_lookup_cache_invalidate(void) {
+    memset(layer_lookup_cache_valid, 0, sizeof(layer_lookup_cache_valid));
+}
+
+/** \brief Layer lookup cache update
+ *
+ * Follows changes of the active layers. Keys which resolve to a layer above the highest
+ * layer that changed keep their entry, everything else is resolved again on its next lookup.
+ */
+static void layer_lookup_cache_update(layer_state_t layers) {
+    layer_state_t changed = layers ^ layer_lookup_cache_state;
+    if (!changed) {
+        return;
+    }
+
+    uint8_t top = get_highest_layer(changed);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_row_t valid = layer_lookup_cache_valid[row];
+        for (uint8_t col = 0; valid; col++, valid >>= 1) {
+            if ((valid & 1) && layer_lookup_cache[row][col] <= top) {
+                layer_lookup_cache_valid[row] &= ~((matrix_row_t)1 << col);
+            }
+        }
+    }
+    layer_lookup_cache_state = layers;
+}
+
+/** \brief Layer lookup cache get
+ *
+ * Gets the layer of the key from the cache, resolving it if needed
+ */
+static uint8_t layer_lookup_cache_get(keypos_t key, layer_state_t layers) {
+    layer_lookup_cache_update(layers);
+
+    matrix_row_t bit = (matrix_row_t)1 << key.col;
+    if (!(layer_lookup_cache_valid[key.row] & bit)) {
+        layer_lookup_cache[key.row][key.col] = layer_find_for_key(key, layers, MAX_LAYER - 1);
+        layer_lookup_cache_valid[key.row] |= bit;
+    }
+    return layer_lookup_cache[key.row][key.col];
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layers = layer_state | default_layer_state;
+#    ifdef LAYER_LOOKUP_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        return layer_lookup_cache_get(key, layers);
+    }
+#    endif
+    return layer_find_for_key(key, layers, MAX_LAYER - 1);
 #else
     return get_highest_layer(default_layer_state);
 #endif
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_layer.h"
 #include "timer.h"
 #include "keycode_config.h"
+#include "benchmark_probe.h"
 #include <string.h>
 
 extern keymap_config_t keymap_config;
@@ -271,14 +272,18 @@ void send_keyboard_report(void) {
 #endif
 
 #ifdef PROTOCOL_VUSB
+    BENCHMARK_PROBE_ENTER(HOST_KEYBOARD_SEND);
     host_keyboard_send(keyboard_report);
+    BENCHMARK_PROBE_EXIT(HOST_KEYBOARD_SEND);
 #else
     static report_keyboard_t last_report;
 
     /* Only send the report if there are changes to propagate to the host. */
     if (memcmp(keyboard_report, &last_report, sizeof(report_keyboard_t)) != 0) {
         memcpy(&last_report, keyboard_report, sizeof(report_keyboard_t));
+        BENCHMARK_PROBE_ENTER(HOST_KEYBOARD_SEND);
         host_keyboard_send(keyboard_report);
+        BENCHMARK_PROBE_EXIT(HOST_KEYBOARD_SEND);
     }
 #endif
 }
@@ -0,0 +1,50 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/**
+ * @brief Timing probes around the hot spots of the scan loop.
+ *
+ * The probes compile to nothing unless BENCHMARK_PROBES is defined, which is
+ * only the case for the host-side benchmarks in `tests/benchmarks` (see
+ * `builddefs/build_bench.mk`). The benchmark harness provides the
+ * implementation of `benchmark_probe_enter()` and `benchmark_probe_exit()`.
+ */
+
+#ifdef BENCHMARK_PROBES
+
+#    ifdef __cplusplus
+extern "C" {
+#    endif
+
+typedef enum {
+    BENCHMARK_PROBE_MATRIX_TASK,
+    BENCHMARK_PROBE_QUANTUM_TASK,
+    BENCHMARK_PROBE_ACTION_EXEC,
+    BENCHMARK_PROBE_HOST_KEYBOARD_SEND,
+    BENCHMARK_PROBE_KEY_OVERRIDE,
+    /* Entered by the color benchmark around each group of conversions. */
+    BENCHMARK_PROBE_HSV_TO_RGB,
+    BENCHMARK_PROBE_HSV_TO_RGB_BATCH,
+    /* Entered by the wear leveling benchmark around each init. */
+    BENCHMARK_PROBE_WEAR_LEVELING_INIT,
+    BENCHMARK_PROBE_COUNT,
+} benchmark_probe_t;
+
+void benchmark_probe_enter(benchmark_probe_t probe);
+void benchmark_probe_exit(benchmark_probe_t probe);
+
+#    ifdef __cplusplus
+}
+#    endif
+
+#    define BENCHMARK_PROBE_ENTER(probe) benchmark_probe_enter(BENCHMARK_PROBE_##probe)
+#    define BENCHMARK_PROBE_EXIT(probe) benchmark_probe_exit(BENCHMARK_PROBE_##probe)
+
+#else
+
+#    define BENCHMARK_PROBE_ENTER(probe)
+#    define BENCHMARK_PROBE_EXIT(probe)
+
+#endif
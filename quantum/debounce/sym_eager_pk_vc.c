@@ -0,0 +1,178 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+Per-key eager algorithm using vertical counters.
+Behaves exactly like sym_eager_pk: after a key changes state, the change is reported
+immediately, then no further inputs are accepted for that key until DEBOUNCE
+milliseconds have occurred.
+Instead of one 8-bit counter per key, bit n of the counters of a whole row is stored
+in counter plane n of that row. Counting down all keys of a row then only takes a few
+bitwise operations per plane, and no memory needs to be allocated.
+*/
+
+#include "matrix.h"
+#include "timer.h"
+#include "quantum.h"
+#include <string.h>
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+
+// Number of counter planes needed to hold DEBOUNCE
+#    if DEBOUNCE > 127
+#        define DEBOUNCE_PLANES 8
+#    elif DEBOUNCE > 63
+#        define DEBOUNCE_PLANES 7
+#    elif DEBOUNCE > 31
+#        define DEBOUNCE_PLANES 6
+#    elif DEBOUNCE > 15
+#        define DEBOUNCE_PLANES 5
+#    elif DEBOUNCE > 7
+#        define DEBOUNCE_PLANES 4
+#    elif DEBOUNCE > 3
+#        define DEBOUNCE_PLANES 3
+#    elif DEBOUNCE > 1
+#        define DEBOUNCE_PLANES 2
+#    else
+#        define DEBOUNCE_PLANES 1
+#    endif
+
+static matrix_row_t debounce_planes[MATRIX_ROWS][DEBOUNCE_PLANES];
+static fast_timer_t last_time;
+static bool         counters_need_update;
+static bool         matrix_need_update;
+static bool         cooked_changed;
+
+static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time);
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    memset(debounce_planes, 0, sizeof(debounce_planes));
+    counters_need_update = false;
+    matrix_need_update   = false;
+}
+
+void debounce_free(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_counters(num_rows, elapsed_time);
+        }
+    }
+
+    if (changed || matrix_need_update) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        transfer_matrix_values(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static inline matrix_row_t counters_active(const matrix_row_t planes[]) {
+    matrix_row_t active = 0;
+    for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+        active |= planes[plane];
+    }
+    return active;
+}
+
+// Subtract elapsed_time from all counters of each row, saturating at zero.
+static void update_debounce_counters(uint8_t num_rows, uint8_t elapsed_time) {
+    counters_need_update = false;
+    matrix_need_update   = false;
+
+    if (elapsed_time >= (1 << DEBOUNCE_PLANES)) {
+        // Every counter has expired, but only report that if any was running
+        for (uint8_t row = 0; row < num_rows; row++) {
+            if (counters_active(debounce_planes[row])) {
+                matrix_need_update = true;
+            }
+        }
+        memset(debounce_planes, 0, sizeof(debounce_planes));
+        return;
+    }
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *planes = debounce_planes[row];
+        matrix_row_t  active = counters_active(planes);
+        if (!active) {
+            continue;
+        }
+
+        // Ripple borrow subtraction of the same constant from every column at once
+        matrix_row_t borrow = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            matrix_row_t subtrahend = (elapsed_time & (1 << plane)) ? (matrix_row_t)~0 : 0;
+            matrix_row_t counter    = planes[plane];
+
+            planes[plane] = counter ^ subtrahend ^ borrow;
+            borrow        = (~counter & (subtrahend | borrow)) | (subtrahend & borrow);
+        }
+
+        // Counters which underflowed have elapsed
+        matrix_row_t remaining = 0;
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            planes[plane] &= ~borrow;
+            remaining |= planes[plane];
+        }
+
+        if (active & ~remaining) {
+            matrix_need_update = true;
+        }
+        if (remaining) {
+            counters_need_update = true;
+        }
+    }
+}
+
+// upload from raw_matrix to final matrix;
+static void transfer_matrix_values(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t *planes = debounce_planes[row];
+        matrix_row_t  ready  = (raw[row] ^ cooked[row]) & ~counters_active(planes);
+        if (!ready) {
+            continue;
+        }
+
+        // The counters of these keys are zero, so only the set bits of DEBOUNCE need loading
+        for (uint8_t plane = 0; plane < DEBOUNCE_PLANES; plane++) {
+            if (DEBOUNCE & (1 << plane)) {
+                planes[plane] |= ready;
+            }
+        }
+        cooked[row] ^= ready;
+        counters_need_update = true;
+        cooked_changed       = true;
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,59 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/*
+ * Tests specific to the vertical counters of sym_eager_pk_vc. The timing
+ * parity with sym_eager_pk is covered by running sym_eager_pk_tests.cpp
+ * against this algorithm as well.
+ */
+
+#include "gtest/gtest.h"
+
+#include "debounce_test_common.h"
+
+TEST_F(DebounceTest, VerticalCountersStaggeredRow) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 0, DOWN}}, {{0, 0, DOWN}}},
+        {1, {{0, 1, DOWN}}, {{0, 1, DOWN}}},
+        {2, {{0, 2, DOWN}}, {{0, 2, DOWN}}},
+        {3, {{0, 3, DOWN}}, {{0, 3, DOWN}}},
+        {4, {{0, 0, UP}, {0, 1, UP}, {0, 2, UP}, {0, 3, UP}}, {}},
+
+        /* Each counter of the row expires on its own */
+        {5, {}, {{0, 0, UP}}},
+        {6, {}, {{0, 1, UP}}},
+        {7, {}, {{0, 2, UP}}},
+        {8, {}, {{0, 3, UP}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, VerticalCountersAllColumns) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{1, 0, DOWN}, {1, 1, DOWN}, {1, 2, DOWN}, {1, 3, DOWN}, {1, 4, DOWN}, {1, 5, DOWN}, {1, 6, DOWN}, {1, 7, DOWN}, {1, 8, DOWN}, {1, 9, DOWN}},
+         {{1, 0, DOWN}, {1, 1, DOWN}, {1, 2, DOWN}, {1, 3, DOWN}, {1, 4, DOWN}, {1, 5, DOWN}, {1, 6, DOWN}, {1, 7, DOWN}, {1, 8, DOWN}, {1, 9, DOWN}}},
+        {1, {{1, 0, UP}, {1, 9, UP}}, {}},
+        {2, {{3, 4, DOWN}}, {{3, 4, DOWN}}},
+
+        {5, {}, {{1, 0, UP}, {1, 9, UP}}},
+        {6, {{3, 4, UP}}, {}},
+        {7, {}, {{3, 4, UP}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, VerticalCountersDelayedScanPartial) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}}, {{0, 1, DOWN}}},
+        {3, {{0, 2, DOWN}}, {{0, 2, DOWN}}},
+
+        /* The first counter expires during the delay, the second one is still running */
+        {6, {{0, 1, UP}, {0, 2, UP}}, {{0, 1, UP}}},
+        {8, {}, {{0, 2, UP}}},
+    });
+    time_jumps_ = true;
+    runEvents();
+}
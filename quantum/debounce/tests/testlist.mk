@@ -3,5 +3,6 @@ TEST_LIST += \
 	debounce_sym_defer_pk \
 	debounce_sym_defer_pr \
 	debounce_sym_eager_pk \
+	debounce_sym_eager_pk_vc \
 	debounce_sym_eager_pr \
 	debounce_asym_eager_defer_pk
@@ -13,32 +13,143 @@
 // Helpers
 //
 
+// Executor tables are managed as binary min-heaps ordered by trigger time, so that the earliest trigger time is always
+// at the top. Entries never move; instead, the heap is a permutation of the table's slots, with the queued executors
+// occupying the first heap positions and the free slots the remaining ones. The permutation is stored within the table
+// itself -- each entry holds the slot at the heap position equal to its own index, as well as its own heap position.
+// Both are stored relative to the entry's index, so that a zero-initialised table is the identity permutation.
+//
+// Tokens roll over the whole 8-bit range, skipping the ones held by queued executors, so that the token of a freed
+// executor is only handed out again once every other token has been.
+
 static deferred_token current_token = 0;
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
-    if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
+// Executor whose callback is being invoked, and whether that callback freed it
+static deferred_executor_t *running_executor       = NULL;
+static bool                 running_executor_freed = false;
+
+static inline uint8_t heap_slot(deferred_executor_t *table, uint8_t pos) {
+    return pos + table[pos].heap_slot;
+}
+
+static inline uint8_t heap_pos(deferred_executor_t *table, uint8_t slot) {
+    return slot + table[slot].heap_pos;
+}
+
+static inline void heap_set(deferred_executor_t *table, uint8_t pos, uint8_t slot) {
+    table[pos].heap_slot = slot - pos;
+    table[slot].heap_pos = pos - slot;
+}
+
+static inline void heap_swap(deferred_executor_t *table, uint8_t pos_a, uint8_t pos_b) {
+    uint8_t slot_a = heap_slot(table, pos_a);
+    heap_set(table, pos_a, heap_slot(table, pos_b));
+    heap_set(table, pos_b, slot_a);
+}
+
+static inline bool heap_before(deferred_executor_t *table, uint8_t pos_a, uint8_t pos_b) {
+    return ((int32_t)TIMER_DIFF_32(table[heap_slot(table, pos_a)].trigger_time, table[heap_slot(table, pos_b)].trigger_time)) < 0;
+}
+
+static inline uint8_t clamp_table_count(size_t table_count) {
+    // Tokens are 8 bits wide, so no more than 255 executors can be queued at once
+    return table_count > UINT8_MAX ? UINT8_MAX : table_count;
+}
+
+// Number of queued executors, found by a binary search for the first heap position holding a free slot.
+static uint8_t heap_count(deferred_executor_t *table, uint8_t table_count) {
+    uint8_t low = 0, high = table_count;
+    while (low < high) {
+        uint8_t mid = low + (high - low) / 2;
+        if (table[heap_slot(table, mid)].token != INVALID_DEFERRED_TOKEN) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
     }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+    return low;
+}
+
+static uint8_t heap_sift_up(deferred_executor_t *table, uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (pos - 1) / 2;
+        if (!heap_before(table, pos, parent)) {
+            break;
         }
+        heap_swap(table, pos, parent);
+        pos = parent;
     }
-    return true;
+    return pos;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
-    deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
-        ++current_token;
-        if (current_token == first) {
-            // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
-            return INVALID_DEFERRED_TOKEN;
+static void heap_sift_down(deferred_executor_t *table, uint8_t pos, uint8_t count) {
+    while (true) {
+        uint8_t  first = pos;
+        uint16_t left  = 2 * pos + 1;
+        uint16_t right = left + 1;
+        if (left < count && heap_before(table, left, first)) {
+            first = left;
+        }
+        if (right < count && heap_before(table, right, first)) {
+            first = right;
+        }
+        if (first == pos) {
+            break;
         }
+        heap_swap(table, pos, first);
+        pos = first;
     }
+}
+
+// Restores the heap order after the trigger time at the given position changed.
+static inline void heap_update(deferred_executor_t *table, uint8_t pos, uint8_t count) {
+    heap_sift_down(table, heap_sift_up(table, pos), count);
+}
+
+static deferred_executor_t *find_executor(deferred_executor_t *table, uint8_t table_count, deferred_token token) {
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return NULL;
+    }
+    for (uint8_t slot = 0; slot < table_count; slot++) {
+        if (table[slot].token == token) {
+            return &table[slot];
+        }
+    }
+    return NULL;
+}
+
+// Only called with a free slot available, so at most 254 tokens are in use and the search always ends.
+static deferred_token allocate_token(deferred_executor_t *table, uint8_t table_count) {
+    do {
+        if (++current_token == INVALID_DEFERRED_TOKEN) {
+            ++current_token;
+        }
+    } while (find_executor(table, table_count, current_token));
     return current_token;
 }
 
+static void free_executor(deferred_executor_t *table, uint8_t table_count, uint8_t slot) {
+    uint8_t count = heap_count(table, table_count);
+    uint8_t pos   = heap_pos(table, slot);
+    uint8_t last  = count - 1;
+
+    // Move the last queued executor into the freed position, and the freed slot to the start of the free ones
+    heap_swap(table, pos, last);
+
+    deferred_executor_t *entry = &table[slot];
+    if (entry == running_executor) {
+        running_executor_freed = true;
+    }
+    entry->token        = INVALID_DEFERRED_TOKEN;
+    entry->trigger_time = 0;
+    entry->callback     = NULL;
+    entry->cb_arg       = NULL;
+
+    if (pos < last) {
+        heap_update(table, pos, last);
+    }
+}
+
 //------------------------------------
 // Advanced API: used when a custom-allocated table is used, primarily for core code.
 //
@@ -49,27 +160,23 @@ deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_coun
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // The first free slot follows the queued executors in the heap
+    uint8_t count = clamp_table_count(table_count);
+    uint8_t pos   = heap_count(table, count);
+    if (pos == count) {
+        // None available
+        return INVALID_DEFERRED_TOKEN;
     }
+    uint8_t slot = heap_slot(table, pos);
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry
+    deferred_executor_t *entry = &table[slot];
+    entry->token               = allocate_token(table, count);
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+    heap_sift_up(table, pos);
+    return entry->token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +186,17 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    uint8_t              count = clamp_table_count(table_count);
+    deferred_executor_t *entry = find_executor(table, count, token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay
+    entry->trigger_time = timer_read32() + delay_ms;
+    heap_update(table, heap_pos(table, entry - table), heap_count(table, count));
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,20 +206,16 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    uint8_t              count = clamp_table_count(table_count);
+    deferred_executor_t *entry = find_executor(table, count, token);
+    if (!entry) {
+        // Not found
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    free_executor(table, count, entry - table);
+    return true;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
@@ -122,15 +225,41 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
         *last_execution_time = now;
 
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry = &table[i];
+        if (!table || table_count == 0) {
+            return;
+        }
+        uint8_t count = clamp_table_count(table_count);
+
+        // Only the top of the heap needs checking to know whether anything is due. The number of invocations is limited to
+        // the number of queued executors, so that executors which fell behind cannot starve the main loop.
+        uint8_t runs = 0;
+        while (true) {
+            uint8_t              slot  = heap_slot(table, 0);
+            deferred_executor_t *entry = &table[slot];
 
             // Check if we're supposed to execute this entry
-            if (entry->token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+            if (entry->token == INVALID_DEFERRED_TOKEN || ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) > 0) {
+                break;
+            }
+            if (runs == 0) {
+                runs = heap_count(table, count);
+            }
+
+            // Invoke the callback and work work out if we should be requeued. The callback may free its own slot, which
+            // may then even be reused by a new executor, so this is tracked rather than inferred from the slot's token.
+            deferred_executor_t *outer_executor = running_executor;
+            bool                 outer_freed    = running_executor_freed;
+
+            running_executor       = entry;
+            running_executor_freed = false;
+            uint32_t delay_ms      = entry->callback(entry->trigger_time, entry->cb_arg);
+            bool     freed         = running_executor_freed;
+
+            running_executor       = outer_executor;
+            running_executor_freed = outer_freed;
 
+            // Skip the entry if the callback cancelled its own execution
+            if (!freed) {
                 // Update the trigger time if we have to repeat, otherwise clear it out
                 if (delay_ms > 0) {
                     // Intentionally add just the delay to the existing trigger time -- this ensures the next
@@ -138,18 +267,36 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
                     // normal circumstances this won't cause issue, but if another executor is invoked that takes a
                     // considerable length of time, then this ensures best-effort timing between invocations.
                     entry->trigger_time += delay_ms;
+                    heap_update(table, heap_pos(table, slot), heap_count(table, count));
                 } else {
                     // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
+                    free_executor(table, count, slot);
                 }
             }
+
+            if (--runs == 0) {
+                break;
+            }
         }
     }
 }
 
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    // Ignore request if the table is not valid
+    if (!table || table_count == 0) {
+        return false;
+    }
+
+    // The earliest trigger time is always at the top of the heap
+    deferred_executor_t *entry = &table[heap_slot(table, 0)];
+    if (entry->token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+
+    *trigger_time = entry->trigger_time;
+    return true;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -169,3 +316,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+bool deferred_exec_next_deadline(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_deadline(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
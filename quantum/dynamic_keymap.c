@@ -98,6 +98,111 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#define DYNAMIC_KEYMAP_KEY_COUNT (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS)
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// Changes which have not been written back yet are lost if the keyboard loses power, 0 writes them back on the next scan
+#    ifndef DYNAMIC_KEYMAP_WRITE_BACK_DELAY
+#        define DYNAMIC_KEYMAP_WRITE_BACK_DELAY 500
+#    endif
+
+#    ifndef DYNAMIC_KEYMAP_WRITE_BACK_BATCH
+#        define DYNAMIC_KEYMAP_WRITE_BACK_BATCH 8
+#    endif
+
+_Static_assert(DYNAMIC_KEYMAP_WRITE_BACK_DELAY <= UINT16_MAX, "DYNAMIC_KEYMAP_WRITE_BACK_DELAY must fit the 16-bit timer");
+
+#    ifdef ENCODER_MAP_ENABLE
+#        define DYNAMIC_KEYMAP_CACHE_COUNT (DYNAMIC_KEYMAP_KEY_COUNT + (DYNAMIC_KEYMAP_LAYER_COUNT * NUM_ENCODERS * 2))
+#    else
+#        define DYNAMIC_KEYMAP_CACHE_COUNT (DYNAMIC_KEYMAP_KEY_COUNT)
+#    endif
+
+// RAM mirror of the keymap followed by the encoder map, in the same order as they are stored in EEPROM.
+// Lookups never touch the EEPROM. Changes are written back once no further changes were made for
+// DYNAMIC_KEYMAP_WRITE_BACK_DELAY, DYNAMIC_KEYMAP_WRITE_BACK_BATCH keycodes per call of dynamic_keymap_task().
+static uint16_t dynamic_keymap_cache[DYNAMIC_KEYMAP_CACHE_COUNT];
+static uint8_t  dynamic_keymap_cache_dirty[(DYNAMIC_KEYMAP_CACHE_COUNT + 7) / 8];
+static bool     dynamic_keymap_cache_loaded  = false;
+static bool     dynamic_keymap_cache_pending = false;
+static uint16_t dynamic_keymap_cache_written = 0;
+
+static uint8_t *dynamic_keymap_cache_to_eeprom_address(uint16_t index) {
+    if (index < DYNAMIC_KEYMAP_KEY_COUNT) {
+        return (uint8_t *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + (index * 2));
+    }
+    return (uint8_t *)(uintptr_t)(DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR + ((index - DYNAMIC_KEYMAP_KEY_COUNT) * 2));
+}
+
+void dynamic_keymap_init(void) {
+    for (uint16_t index = 0; index < DYNAMIC_KEYMAP_CACHE_COUNT; index++) {
+        uint8_t *address = dynamic_keymap_cache_to_eeprom_address(index);
+        // Big endian, so we can read/write EEPROM directly from host if we want
+        dynamic_keymap_cache[index] = (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+    memset(dynamic_keymap_cache_dirty, 0, sizeof(dynamic_keymap_cache_dirty));
+    dynamic_keymap_cache_loaded  = true;
+    dynamic_keymap_cache_pending = false;
+}
+
+static inline uint16_t dynamic_keymap_cache_get(uint16_t index) {
+    if (!dynamic_keymap_cache_loaded) {
+        dynamic_keymap_init();
+    }
+    return dynamic_keymap_cache[index];
+}
+
+static void dynamic_keymap_cache_set(uint16_t index, uint16_t keycode) {
+    if (dynamic_keymap_cache_get(index) == keycode) {
+        return;
+    }
+    dynamic_keymap_cache[index] = keycode;
+    dynamic_keymap_cache_dirty[index / 8] |= 1 << (index % 8);
+    dynamic_keymap_cache_pending = true;
+    dynamic_keymap_cache_written = timer_read();
+}
+
+// Marks every keycode as changed, for when the EEPROM may no longer match the cache, e.g. after an erase.
+static void dynamic_keymap_cache_mark_all_dirty(void) {
+    for (uint16_t index = 0; index < DYNAMIC_KEYMAP_CACHE_COUNT; index++) {
+        dynamic_keymap_cache_dirty[index / 8] |= 1 << (index % 8);
+    }
+    dynamic_keymap_cache_pending = true;
+}
+
+// Writes up to `count` changed keycodes back to EEPROM, returns false once none are left.
+static bool dynamic_keymap_cache_write_back(uint16_t count) {
+    for (uint16_t byte = 0; byte < sizeof(dynamic_keymap_cache_dirty); byte++) {
+        while (dynamic_keymap_cache_dirty[byte]) {
+            if (count-- == 0) {
+                return true;
+            }
+
+            uint8_t  bit     = __builtin_ctz(dynamic_keymap_cache_dirty[byte]);
+            uint16_t index   = byte * 8 + bit;
+            uint8_t *address = dynamic_keymap_cache_to_eeprom_address(index);
+            eeprom_update_byte(address, (uint8_t)(dynamic_keymap_cache[index] >> 8));
+            eeprom_update_byte(address + 1, (uint8_t)(dynamic_keymap_cache[index] & 0xFF));
+            dynamic_keymap_cache_dirty[byte] &= ~(1 << bit);
+        }
+    }
+    dynamic_keymap_cache_pending = false;
+    return false;
+}
+
+void dynamic_keymap_flush(void) {
+    if (dynamic_keymap_cache_pending) {
+        dynamic_keymap_cache_write_back(DYNAMIC_KEYMAP_CACHE_COUNT);
+    }
+}
+
+void dynamic_keymap_task(void) {
+    if (dynamic_keymap_cache_pending && timer_elapsed(dynamic_keymap_cache_written) >= DYNAMIC_KEYMAP_WRITE_BACK_DELAY) {
+        dynamic_keymap_cache_write_back(DYNAMIC_KEYMAP_WRITE_BACK_BATCH);
+    }
+}
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -109,19 +214,28 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    return dynamic_keymap_cache_get((layer * MATRIX_ROWS * MATRIX_COLS) + (row * MATRIX_COLS) + column);
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_cache_set((layer * MATRIX_ROWS * MATRIX_COLS) + (row * MATRIX_COLS) + column, keycode);
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#endif
+    layer_lookup_cache_invalidate();
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -131,19 +245,27 @@ void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t encoder_id
 
 uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
+#    ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    return dynamic_keymap_cache_get(DYNAMIC_KEYMAP_KEY_COUNT + (layer * NUM_ENCODERS * 2) + (encoder_id * 2) + (clockwise ? 0 : 1));
+#    else
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
     keycode |= eeprom_read_byte(address + (clockwise ? 0 : 2) + 1);
     return keycode;
+#    endif
 }
 
 void dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
+#    ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_cache_set(DYNAMIC_KEYMAP_KEY_COUNT + (layer * NUM_ENCODERS * 2) + (encoder_id * 2) + (clockwise ? 0 : 1), keycode);
+#    else
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+#    endif
 }
 #endif // ENCODER_MAP_ENABLE
 
@@ -171,15 +293,26 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // Callers expect the EEPROM to be valid once this returns. The EEPROM may have been erased underneath the cache
+    // (eeconfig_init_quantum() does so), so keycodes which already matched the defaults have to be written as well.
+    dynamic_keymap_cache_mark_all_dirty();
+    dynamic_keymap_flush();
+#endif
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            uint16_t keycode = dynamic_keymap_cache_get((offset + i) / 2);
+            *target          = ((offset + i) % 2) ? (keycode & 0xFF) : (keycode >> 8);
+#else
             *target = eeprom_read_byte(source);
+#endif
         } else {
             *target = 0x00;
         }
@@ -190,15 +323,26 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *source                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+            uint16_t keycode = dynamic_keymap_cache_get((offset + i) / 2);
+            if ((offset + i) % 2) {
+                keycode = (keycode & 0xFF00) | *source;
+            } else {
+                keycode = (keycode & 0x00FF) | (*source << 8);
+            }
+            dynamic_keymap_cache_set((offset + i) / 2, keycode);
+#else
             eeprom_update_byte(target, *source);
+#endif
         }
         source++;
         target++;
     }
+    layer_lookup_cache_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -226,7 +370,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -240,7 +384,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -260,6 +404,16 @@ void dynamic_keymap_macro_reset(void) {
     }
 }
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+// The end of the macro buffer reads as a terminator, as the buffer may be rewritten while a macro is being typed out
+static char dynamic_keymap_macro_read(const char *p) {
+    if (p >= (const char *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE)) {
+        return 0;
+    }
+    return eeprom_read_byte((const uint8_t *)p);
+}
+#endif
+
 void dynamic_keymap_macro_send(uint8_t id) {
     if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
         return;
@@ -290,6 +444,10 @@ void dynamic_keymap_macro_send(uint8_t id) {
         ++p;
     }
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // The macro is read straight from EEPROM while it is being typed out
+    send_string_with_reader_async((const char *)p, DYNAMIC_KEYMAP_MACRO_DELAY, dynamic_keymap_macro_read);
+#else
     // Send the macro string by making a temporary string.
     char data[8] = {0};
     // We already checked there was a null at the end of
@@ -343,4 +501,5 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
     }
+#endif
 }
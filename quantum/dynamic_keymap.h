@@ -27,6 +27,14 @@ uint16_t dynamic_keymap_get_encoder(uint8_t layer, uint8_t encoder_id, bool cloc
 void     dynamic_keymap_set_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode);
 #endif // ENCODER_MAP_ENABLE
 void dynamic_keymap_reset(void);
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// (Re)loads the RAM copy of the keymap from EEPROM
+void dynamic_keymap_init(void);
+// Writes pending changes back to EEPROM, a few keycodes at a time
+void dynamic_keymap_task(void);
+// Writes all pending changes back to EEPROM before returning
+void dynamic_keymap_flush(void);
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
 // These get/set the keycodes as stored in the EEPROM buffer
 // Data is big-endian 16-bit values (the keycodes)
 // Order is by layer/row/column
@@ -33,6 +33,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "benchmark_probe.h"
+#include "task_profile.h"
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -81,12 +83,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DOUBLE_BANK)
+#    include "wear_leveling.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -351,6 +359,9 @@ void keyboard_init(void) {
 #ifdef VIA_ENABLE
     via_init();
 #endif
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_CACHE)
+    dynamic_keymap_init();
+#endif
 #ifdef SPLIT_KEYBOARD
     split_pre_init();
 #endif
@@ -404,7 +415,7 @@ void keyboard_init(void) {
     bluetooth_init();
 #endif
 
-#if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
+#if (defined(DEBUG_MATRIX_SCAN_RATE) || defined(DEBUG_TASK_PROFILE)) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
 
@@ -438,6 +449,80 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#ifndef MATRIX_EVENT_QUEUE_SIZE
+#    define MATRIX_EVENT_QUEUE_SIZE 16
+#endif
+
+#if (MATRIX_EVENT_QUEUE_SIZE & (MATRIX_EVENT_QUEUE_SIZE - 1)) || (MATRIX_EVENT_QUEUE_SIZE > 128)
+#    error MATRIX_EVENT_QUEUE_SIZE must be a power of two no larger than 128
+#endif
+
+#if (MATRIX_COLS <= 16)
+#    define matrix_row_ctz(bits) __builtin_ctz(bits)
+#else
+#    define matrix_row_ctz(bits) __builtin_ctzl(bits)
+#endif
+
+/* Key changes found by the matrix scan, waiting to be handed to action_exec */
+static keyevent_t matrix_events[MATRIX_EVENT_QUEUE_SIZE];
+static uint8_t    matrix_events_head = 0;
+static uint8_t    matrix_events_tail = 0;
+
+#define MATRIX_EVENTS_COUNT() ((uint8_t)(matrix_events_head - matrix_events_tail))
+
+/**
+ * @brief Gets the time a change of a matrix row happened at.
+ *
+ * Defaults to the start of the scan which found the change. Split keyboards
+ * with SPLIT_MATRIX_PUSH use the time the slave side pushed its matrix at.
+ */
+__attribute__((weak)) uint16_t matrix_event_time(uint8_t row, uint16_t scan_time) {
+    return scan_time;
+}
+
+/**
+ * @brief Queues the changes between `matrix_previous` and the current matrix.
+ *
+ * All events are stamped with the time the scan which found them was started,
+ * so that processing earlier events does not skew the timing of later ones.
+ * Event times never go backwards, as the tapping logic only compares them
+ * forwards. Changes that do not fit into the queue are left in
+ * `matrix_previous`, so they are picked up again by the next scan.
+ */
+static void matrix_events_collect(matrix_row_t matrix_previous[], uint16_t scan_time) {
+    static uint16_t last_event_time = 0;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t current_row = matrix_get_row(row);
+        matrix_row_t       row_changes = current_row ^ matrix_previous[row];
+
+        if (!row_changes || has_ghost_in_row(row, current_row)) {
+            continue;
+        }
+
+        // A change backdated to before an event already handed out is moved up to it. Comparing
+        // the ages keeps a long pause, during which the 16 bit times wrap, from holding times back.
+        uint16_t event_time = matrix_event_time(row, scan_time);
+        if (last_event_time && TIMER_DIFF_16(scan_time, event_time) > TIMER_DIFF_16(scan_time, last_event_time)) {
+            event_time = last_event_time;
+        }
+        last_event_time = event_time;
+
+        while (row_changes) {
+            if (MATRIX_EVENTS_COUNT() == MATRIX_EVENT_QUEUE_SIZE) {
+                return;
+            }
+
+            const uint8_t      col      = matrix_row_ctz(row_changes);
+            const matrix_row_t col_mask = MATRIX_ROW_SHIFTER << col;
+
+            matrix_events[matrix_events_head++ % MATRIX_EVENT_QUEUE_SIZE] = (keyevent_t){.key = MAKE_KEYPOS(row, col), .pressed = current_row & col_mask, .time = event_time};
+            matrix_previous[row] ^= col_mask;
+            row_changes &= row_changes - 1;
+        }
+    }
+}
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -448,6 +533,7 @@ static inline void generate_tick_event(void) {
 static bool matrix_task(void) {
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
+    const uint16_t scan_time = timer_read() | 1;
     matrix_scan();
 
     bool matrix_changed = false;
@@ -469,28 +555,18 @@ static bool matrix_task(void) {
 
     const bool process_keypress = should_process_keypress();
 
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
-
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
-            continue;
-        }
-
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+    matrix_events_collect(matrix_previous, scan_time);
 
-                if (process_keypress) {
-                    action_exec(MAKE_KEYEVENT(row, col, key_pressed));
-                }
+    while (MATRIX_EVENTS_COUNT()) {
+        keyevent_t event = matrix_events[matrix_events_tail++ % MATRIX_EVENT_QUEUE_SIZE];
 
-                switch_events(row, col, key_pressed);
-            }
+        if (process_keypress) {
+            BENCHMARK_PROBE_ENTER(ACTION_EXEC);
+            action_exec(event);
+            BENCHMARK_PROBE_EXIT(ACTION_EXEC);
         }
 
-        matrix_previous[row] = current_row;
+        switch_events(event.key.row, event.key.col, event.pressed);
     }
 
     return matrix_changed;
@@ -527,89 +603,141 @@ void quantum_task(void) {
 #endif
 
 #if defined(AUDIO_ENABLE) && !defined(NO_MUSIC_MODE)
+    TASK_PROFILE_BEGIN(MUSIC);
     music_task();
+    TASK_PROFILE_END(MUSIC);
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
+    TASK_PROFILE_BEGIN(KEY_OVERRIDE);
     key_override_task();
+    TASK_PROFILE_END(KEY_OVERRIDE);
 #endif
 
 #ifdef SEQUENCER_ENABLE
+    TASK_PROFILE_BEGIN(SEQUENCER);
     sequencer_task();
+    TASK_PROFILE_END(SEQUENCER);
 #endif
 
 #ifdef TAP_DANCE_ENABLE
+    TASK_PROFILE_BEGIN(TAP_DANCE);
     tap_dance_task();
+    TASK_PROFILE_END(TAP_DANCE);
 #endif
 
 #ifdef COMBO_ENABLE
+    TASK_PROFILE_BEGIN(COMBO);
     combo_task();
+    TASK_PROFILE_END(COMBO);
 #endif
 
 #ifdef WPM_ENABLE
+    TASK_PROFILE_BEGIN(WPM);
     decay_wpm();
+    TASK_PROFILE_END(WPM);
 #endif
 
 #ifdef HAPTIC_ENABLE
+    TASK_PROFILE_BEGIN(HAPTIC);
     haptic_task();
+    TASK_PROFILE_END(HAPTIC);
 #endif
 
 #ifdef DIP_SWITCH_ENABLE
+    TASK_PROFILE_BEGIN(DIP_SWITCH);
     dip_switch_read(false);
+    TASK_PROFILE_END(DIP_SWITCH);
 #endif
 
 #ifdef AUTO_SHIFT_ENABLE
+    TASK_PROFILE_BEGIN(AUTO_SHIFT);
     autoshift_matrix_scan();
+    TASK_PROFILE_END(AUTO_SHIFT);
 #endif
 
 #ifdef CAPS_WORD_ENABLE
+    TASK_PROFILE_BEGIN(CAPS_WORD);
     caps_word_task();
+    TASK_PROFILE_END(CAPS_WORD);
 #endif
 
 #ifdef SECURE_ENABLE
+    TASK_PROFILE_BEGIN(SECURE);
     secure_task();
+    TASK_PROFILE_END(SECURE);
+#endif
+
+#ifdef LEADER_ENABLE
+    TASK_PROFILE_BEGIN(LEADER);
+    leader_task();
+    TASK_PROFILE_END(LEADER);
 #endif
 }
 
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
+    TASK_PROFILE_BEGIN(KEYBOARD_TASK);
+
+    BENCHMARK_PROBE_ENTER(MATRIX_TASK);
+    TASK_PROFILE_BEGIN(MATRIX);
     const bool matrix_changed = matrix_task();
+    TASK_PROFILE_END(MATRIX);
+    BENCHMARK_PROBE_EXIT(MATRIX_TASK);
     if (matrix_changed) {
         last_matrix_activity_trigger();
     }
 
+    BENCHMARK_PROBE_ENTER(QUANTUM_TASK);
+    TASK_PROFILE_BEGIN(QUANTUM);
     quantum_task();
+    TASK_PROFILE_END(QUANTUM);
+    BENCHMARK_PROBE_EXIT(QUANTUM_TASK);
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
+    TASK_PROFILE_BEGIN(SPLIT_WATCHDOG);
     split_watchdog_task();
+    TASK_PROFILE_END(SPLIT_WATCHDOG);
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
+    TASK_PROFILE_BEGIN(RGBLIGHT);
     rgblight_task();
+    TASK_PROFILE_END(RGBLIGHT);
 #endif
 
 #ifdef LED_MATRIX_ENABLE
+    TASK_PROFILE_BEGIN(LED_MATRIX);
     led_matrix_task();
+    TASK_PROFILE_END(LED_MATRIX);
 #endif
 #ifdef RGB_MATRIX_ENABLE
+    TASK_PROFILE_BEGIN(RGB_MATRIX);
     rgb_matrix_task();
+    TASK_PROFILE_END(RGB_MATRIX);
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
+    TASK_PROFILE_BEGIN(BACKLIGHT);
     backlight_task();
+    TASK_PROFILE_END(BACKLIGHT);
 #    endif
 #endif
 
 #ifdef ENCODER_ENABLE
+    TASK_PROFILE_BEGIN(ENCODER);
     const bool encoders_changed = encoder_read();
+    TASK_PROFILE_END(ENCODER);
     if (encoders_changed) {
         last_encoder_activity_trigger();
     }
 #endif
 
 #ifdef OLED_ENABLE
+    TASK_PROFILE_BEGIN(OLED);
     oled_task();
+    TASK_PROFILE_END(OLED);
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
 #        ifdef ENCODER_ENABLE
@@ -621,7 +749,9 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
+    TASK_PROFILE_BEGIN(ST7565);
     st7565_task();
+    TASK_PROFILE_END(ST7565);
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
 #        ifdef ENCODER_ENABLE
@@ -634,34 +764,76 @@ void keyboard_task(void) {
 
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
+    TASK_PROFILE_BEGIN(MOUSEKEY);
     mousekey_task();
+    TASK_PROFILE_END(MOUSEKEY);
 #endif
 
 #ifdef PS2_MOUSE_ENABLE
+    TASK_PROFILE_BEGIN(PS2_MOUSE);
     ps2_mouse_task();
+    TASK_PROFILE_END(PS2_MOUSE);
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
+    TASK_PROFILE_BEGIN(POINTING_DEVICE);
     pointing_device_task();
+    TASK_PROFILE_END(POINTING_DEVICE);
 #endif
 
 #ifdef MIDI_ENABLE
+    TASK_PROFILE_BEGIN(MIDI);
     midi_task();
+    TASK_PROFILE_END(MIDI);
 #endif
 
 #ifdef VELOCIKEY_ENABLE
+    TASK_PROFILE_BEGIN(VELOCIKEY);
     if (velocikey_enabled()) {
         velocikey_decelerate();
     }
+    TASK_PROFILE_END(VELOCIKEY);
 #endif
 
 #ifdef JOYSTICK_ENABLE
+    TASK_PROFILE_BEGIN(JOYSTICK);
     joystick_task();
+    TASK_PROFILE_END(JOYSTICK);
 #endif
 
 #ifdef BLUETOOTH_ENABLE
+    TASK_PROFILE_BEGIN(BLUETOOTH);
     bluetooth_task();
+    TASK_PROFILE_END(BLUETOOTH);
+#endif
+
+#if defined(DYNAMIC_KEYMAP_ENABLE) && defined(DYNAMIC_KEYMAP_RAM_CACHE)
+    TASK_PROFILE_BEGIN(DYNAMIC_KEYMAP);
+    dynamic_keymap_task();
+    TASK_PROFILE_END(DYNAMIC_KEYMAP);
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_DOUBLE_BANK)
+    // Only spend time on flash erases and copies while there is no matrix activity
+    if (!matrix_changed) {
+        TASK_PROFILE_BEGIN(WEAR_LEVELING);
+        wear_leveling_task();
+        TASK_PROFILE_END(WEAR_LEVELING);
+    }
 #endif
 
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_ENABLE)
+    TASK_PROFILE_BEGIN(SEND_STRING);
+    send_string_async_task();
+    TASK_PROFILE_END(SEND_STRING);
+#endif
+
+    TASK_PROFILE_BEGIN(LED);
     led_task();
+    TASK_PROFILE_END(LED);
+
+    TASK_PROFILE_END(KEYBOARD_TASK);
+#ifdef DEBUG_TASK_PROFILE
+    task_profile_task();
+#endif
 }
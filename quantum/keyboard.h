@@ -119,6 +119,8 @@ uint32_t last_encoder_activity_elapsed(void); // Number of milliseconds since th
 
 uint32_t get_matrix_scan_rate(void);
 
+uint16_t matrix_event_time(uint8_t row, uint16_t scan_time); // Time a change of the row happened at, the start of the scan by default
+
 #ifdef __cplusplus
 }
 #endif
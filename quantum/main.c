@@ -15,6 +15,7 @@
  */
 
 #include "keyboard.h"
+#include "task_profile.h"
 
 void platform_setup(void);
 
@@ -62,15 +63,21 @@ int main(void) {
 #ifdef QUANTUM_PAINTER_ENABLE
         // Run Quantum Painter animations
         void qp_internal_animation_tick(void);
+        TASK_PROFILE_BEGIN(QUANTUM_PAINTER);
         qp_internal_animation_tick();
+        TASK_PROFILE_END(QUANTUM_PAINTER);
 #endif
 
 #ifdef DEFERRED_EXEC_ENABLE
         // Run deferred executions
         void deferred_exec_task(void);
+        TASK_PROFILE_BEGIN(DEFERRED_EXEC);
         deferred_exec_task();
+        TASK_PROFILE_END(DEFERRED_EXEC);
 #endif // DEFERRED_EXEC_ENABLE
 
+        TASK_PROFILE_BEGIN(HOUSEKEEPING);
         housekeeping_task();
+        TASK_PROFILE_END(HOUSEKEEPING);
     }
 }
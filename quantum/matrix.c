@@ -267,6 +267,178 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef MATRIX_IDLE_WAKE
+#    if defined(DIRECT_PINS) || !defined(MATRIX_ROW_PINS) || !defined(MATRIX_COL_PINS)
+#        error MATRIX_IDLE_WAKE requires a diode matrix defined by MATRIX_ROW_PINS and MATRIX_COL_PINS
+#    endif
+
+#    ifndef MATRIX_IDLE_WAKE_TIMEOUT
+#        define MATRIX_IDLE_WAKE_TIMEOUT 20
+#    endif
+
+#    if (DIODE_DIRECTION == COL2ROW)
+#        define IDLE_WAKE_OUTPUT_COUNT ROWS_PER_HAND
+#        define IDLE_WAKE_INPUT_COUNT MATRIX_COLS
+#        define IDLE_WAKE_INPUT_PINS col_pins
+#        define idle_wake_select_output(x) select_row(x)
+#        define idle_wake_unselect_outputs() unselect_rows()
+#    else
+#        define IDLE_WAKE_OUTPUT_COUNT MATRIX_COLS
+#        define IDLE_WAKE_INPUT_COUNT ROWS_PER_HAND
+#        define IDLE_WAKE_INPUT_PINS row_pins
+#        define idle_wake_select_output(x) select_col(x)
+#        define idle_wake_unselect_outputs() unselect_cols()
+#    endif
+
+static bool          matrix_idle        = false;
+static bool          idle_wake_armed    = false;
+static volatile bool idle_wake_pending  = false;
+static uint32_t      idle_last_activity = 0;
+
+/** \brief Signals activity on one of the input lines while the matrix is idle.
+ *
+ * To be called from the pin interrupt armed by matrix_idle_wake_arm_pin().
+ */
+void matrix_idle_wake_signal(void) {
+    idle_wake_pending = true;
+}
+
+#    if defined(PROTOCOL_CHIBIOS) && (PAL_USE_CALLBACKS == TRUE)
+static void idle_wake_pal_callback(void *arg) {
+    (void)arg;
+    matrix_idle_wake_signal();
+}
+
+__attribute__((weak)) bool matrix_idle_wake_arm_pin(pin_t pin) {
+    palEnableLineEvent(pin, PAL_EVENT_MODE_FALLING_EDGE);
+    palSetLineCallback(pin, idle_wake_pal_callback, NULL);
+    return true;
+}
+
+__attribute__((weak)) void matrix_idle_wake_disarm_pin(pin_t pin) {
+    palDisableLineEvent(pin);
+}
+
+#        if defined(MCU_STM32) && !defined(GD32VF103)
+__attribute__((weak)) void matrix_idle_sleep(void) {
+    // Interrupts are masked so that an edge arriving after the check still wakes the core from WFI.
+    __disable_irq();
+    if (!idle_wake_pending) {
+        __WFI();
+    }
+    __enable_irq();
+}
+#        else
+__attribute__((weak)) void matrix_idle_sleep(void) {}
+#        endif
+#    else
+// Without pin interrupts the input lines are polled, which still replaces a full scan by a single pass over the inputs.
+__attribute__((weak)) bool matrix_idle_wake_arm_pin(pin_t pin) {
+    return false;
+}
+
+__attribute__((weak)) void matrix_idle_wake_disarm_pin(pin_t pin) {}
+
+__attribute__((weak)) void matrix_idle_sleep(void) {}
+#    endif
+
+static bool idle_wake_inputs_active(void) {
+    for (uint8_t x = 0; x < IDLE_WAKE_INPUT_COUNT; x++) {
+        if (readMatrixPin(IDLE_WAKE_INPUT_PINS[x]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void matrix_idle_enter(void) {
+    // Drive all outputs, so that any key press pulls its input line low
+    for (uint8_t x = 0; x < IDLE_WAKE_OUTPUT_COUNT; x++) {
+        idle_wake_select_output(x);
+    }
+    matrix_output_select_delay();
+
+    idle_wake_pending = false;
+    idle_wake_armed   = true;
+    for (uint8_t x = 0; x < IDLE_WAKE_INPUT_COUNT; x++) {
+        if (IDLE_WAKE_INPUT_PINS[x] != NO_PIN) {
+            idle_wake_armed &= matrix_idle_wake_arm_pin(IDLE_WAKE_INPUT_PINS[x]);
+        }
+    }
+
+    // A key already held, or a bounce landing before the interrupts were armed, raises no edge
+    if (idle_wake_inputs_active()) {
+        idle_wake_pending = true;
+    }
+    matrix_idle = true;
+}
+
+static void matrix_idle_exit(void) {
+    for (uint8_t x = 0; x < IDLE_WAKE_INPUT_COUNT; x++) {
+        if (IDLE_WAKE_INPUT_PINS[x] != NO_PIN) {
+            matrix_idle_wake_disarm_pin(IDLE_WAKE_INPUT_PINS[x]);
+        }
+    }
+
+    idle_wake_unselect_outputs();
+    matrix_output_unselect_delay(0, true);
+    matrix_idle = false;
+}
+
+/** \brief Checks whether the matrix can keep skipping scans
+ *
+ * The inputs are read once after arming the interrupts, and again whenever an
+ * interrupt fired, or on every call when no interrupts are available.
+ *
+ * \return true if the matrix is idle and does not need to be scanned
+ */
+static bool matrix_idle_task(void) {
+    if (!matrix_idle) {
+        return false;
+    }
+
+    if (idle_wake_armed && !idle_wake_pending) {
+#    ifdef MATRIX_IDLE_WAKE_SLEEP
+        matrix_idle_sleep();
+#    endif
+        if (!idle_wake_pending) {
+            return true;
+        }
+    }
+
+    idle_wake_pending = false;
+    if (!idle_wake_inputs_active()) {
+        return true;
+    }
+
+    matrix_idle_exit();
+    return false;
+}
+
+static void matrix_idle_init(void) {
+    matrix_idle        = false;
+    idle_wake_armed    = false;
+    idle_wake_pending  = false;
+    idle_last_activity = timer_read32();
+}
+
+static void matrix_idle_update(matrix_row_t debounced[], bool changed) {
+    if (matrix_idle) {
+        return;
+    }
+
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        changed |= raw_matrix[row] | debounced[row];
+    }
+
+    if (changed) {
+        idle_last_activity = timer_read32();
+    } else if (timer_elapsed32(idle_last_activity) >= MATRIX_IDLE_WAKE_TIMEOUT) {
+        matrix_idle_enter();
+    }
+}
+#endif // MATRIX_IDLE_WAKE
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
@@ -306,6 +478,10 @@ void matrix_init(void) {
 
     debounce_init(ROWS_PER_HAND);
 
+#ifdef MATRIX_IDLE_WAKE
+    matrix_idle_init();
+#endif
+
     matrix_init_quantum();
 }
 
@@ -317,9 +493,7 @@ __attribute__((weak)) bool transport_master_if_connected(matrix_row_t master_mat
 }
 #endif
 
-uint8_t matrix_scan(void) {
-    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
-
+static inline void matrix_read(matrix_row_t curr_matrix[]) {
 #if defined(DIRECT_PINS) || (DIODE_DIRECTION == COL2ROW)
     // Set row, read cols
     for (uint8_t current_row = 0; current_row < ROWS_PER_HAND; current_row++) {
@@ -332,14 +506,34 @@ uint8_t matrix_scan(void) {
         matrix_read_rows_on_col(curr_matrix, current_col, row_shifter);
     }
 #endif
+}
+
+uint8_t matrix_scan(void) {
+    matrix_row_t curr_matrix[MATRIX_ROWS] = {0};
+
+#ifdef MATRIX_IDLE_WAKE
+    // Nothing is pressed, so the idle matrix reads as all zeroes
+    if (!matrix_idle_task()) {
+        matrix_read(curr_matrix);
+    }
+#else
+    matrix_read(curr_matrix);
+#endif
 
     bool changed = memcmp(raw_matrix, curr_matrix, sizeof(curr_matrix)) != 0;
     if (changed) memcpy(raw_matrix, curr_matrix, sizeof(curr_matrix));
 
 #ifdef SPLIT_KEYBOARD
-    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
+    bool local_changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
+#    ifdef MATRIX_IDLE_WAKE
+    matrix_idle_update(matrix + thisHand, local_changed);
+#    endif
+    changed = local_changed | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+#    ifdef MATRIX_IDLE_WAKE
+    matrix_idle_update(matrix, changed);
+#    endif
     matrix_scan_quantum();
 #endif
     return (uint8_t)changed;
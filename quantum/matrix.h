@@ -72,6 +72,15 @@ void matrix_scan_kb(void);
 void matrix_init_user(void);
 void matrix_scan_user(void);
 
+#ifdef MATRIX_IDLE_WAKE
+#    include "gpio.h"
+/* idle wake: arm/disarm the interrupt of an input line, sleep until one fires */
+bool matrix_idle_wake_arm_pin(pin_t pin);
+void matrix_idle_wake_disarm_pin(pin_t pin);
+void matrix_idle_wake_signal(void);
+void matrix_idle_sleep(void);
+#endif
+
 #ifdef SPLIT_KEYBOARD
 bool matrix_post_scan(void);
 void matrix_slave_scan_kb(void);
@@ -163,17 +163,23 @@ static bool qgf_read_frame_offset(qp_stream_t *stream, uint16_t frame_number, ui
 }
 
 void qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number) {
-    // Read the offset
+    // The frame offsets immediately follow the graphics descriptor, and were validated along with the rest of the stream
+    // when it was loaded -- so there's no need to parse the descriptors again, just read the offset directly
     uint32_t offset = 0;
-    qgf_read_frame_offset(stream, frame_number, &offset);
+    qp_stream_setpos(stream, sizeof(qgf_graphics_descriptor_v1_t) + sizeof(qgf_frame_offsets_v1_t) + frame_number * sizeof(uint32_t));
+    qp_stream_read(&offset, sizeof(uint32_t), 1, stream);
 
     // Move to the offset
     qp_stream_setpos(stream, offset);
 }
 
 bool qgf_validate_frame_descriptor(qp_stream_t *stream, uint16_t frame_number, uint8_t *bpp, bool *has_palette, bool *is_delta) {
-    // Seek to the correct location
-    qgf_seek_to_frame_descriptor(stream, frame_number);
+    // Seek to the correct location, validating the frame offsets in the process
+    uint32_t offset = 0;
+    if (!qgf_read_frame_offset(stream, frame_number, &offset)) {
+        return false;
+    }
+    qp_stream_setpos(stream, offset);
 
     // Read the raw descriptor
     qgf_frame_v1_t frame_descriptor;
@@ -64,6 +64,23 @@
 #    define QUANTUM_PAINTER_SUPPORTS_256_PALETTE FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_DECODE_CACHE_SIZE
+/**
+ * @def This controls the amount of RAM, in bytes, used to cache decoded glyphs and image frames in the native pixel
+ *      format of the display they were drawn to. Redrawing a cached glyph or frame with the same colors skips reading
+ *      and decoding the asset entirely. The least recently used entries are discarded when space runs out. Defaults to
+ *      0, which disables the cache.
+ */
+#    define QUANTUM_PAINTER_DECODE_CACHE_SIZE 0
+#endif
+
+#ifndef QUANTUM_PAINTER_DECODE_CACHE_ENTRIES
+/**
+ * @def This controls the maximum number of glyphs and image frames held in the decode cache at any one time.
+ */
+#    define QUANTUM_PAINTER_DECODE_CACHE_ENTRIES 16
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter types
 
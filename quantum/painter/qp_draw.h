@@ -83,3 +83,49 @@ struct qp_internal_pixel_output_state {
 bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg);
 
 qp_internal_byte_input_callback qp_internal_prepare_input_state(struct qp_internal_byte_input_state* input_state, painter_compression_t compression);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter decode cache
+
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+
+typedef struct qp_internal_cache_entry_t {
+    // Key
+    painter_device_t device;
+    const void*      asset;
+    uint32_t         key; // glyph code point, or frame number
+    qp_pixel_t       fg_hsv888;
+    qp_pixel_t       bg_hsv888;
+    // Location of the pixel data relative to the drawing position
+    uint16_t left;
+    uint16_t top;
+    uint16_t width;
+    uint16_t height;
+    // Frame delay, for animations
+    uint16_t delay;
+    // Housekeeping
+    uint32_t offset;
+    uint32_t length;
+    uint32_t last_used;
+} qp_internal_cache_entry_t;
+
+// Finds a previously decoded glyph or frame, marking it as the most recently used. Returns NULL if not cached.
+qp_internal_cache_entry_t* qp_internal_cache_find(painter_device_t device, const void* asset, uint32_t key, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888);
+
+// Allocates an entry for `pixel_count` native pixels, discarding the least recently used entries as required. Returns NULL if it can never fit.
+// Any entry pointers previously returned become invalid.
+qp_internal_cache_entry_t* qp_internal_cache_alloc(painter_device_t device, const void* asset, uint32_t key, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t pixel_count);
+
+// Returns the native pixel data of an entry.
+uint8_t* qp_internal_cache_data(const qp_internal_cache_entry_t* entry);
+
+// Decodes pixel data into an entry using the global pixel lookup table. The entry is discarded if decoding fails.
+bool qp_internal_cache_fill(qp_internal_cache_entry_t* entry, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg);
+
+// Sends the pixel data of an entry to the display, at the supplied drawing position. Requires comms to already be started.
+bool qp_internal_cache_blit(painter_device_t device, const qp_internal_cache_entry_t* entry, uint16_t x, uint16_t y);
+
+// Discards all entries decoded from the supplied asset, such as when it is closed.
+void qp_internal_cache_invalidate(const void* asset);
+
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
@@ -0,0 +1,137 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "qp_internal.h"
+#include "qp_draw.h"
+
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Cache storage
+
+// Entries are kept ordered by offset, with their pixel data packed at the start of the pool
+static uint32_t                  cache_pool[(QUANTUM_PAINTER_DECODE_CACHE_SIZE + 3) / 4];
+static qp_internal_cache_entry_t cache_entries[QUANTUM_PAINTER_DECODE_CACHE_ENTRIES];
+static uint8_t                   cache_count = 0;
+static uint32_t                  cache_used  = 0;
+static uint32_t                  cache_tick  = 0;
+
+uint8_t *qp_internal_cache_data(const qp_internal_cache_entry_t *entry) {
+    return ((uint8_t *)cache_pool) + entry->offset;
+}
+
+static inline bool hsv888_equal(qp_pixel_t a, qp_pixel_t b) {
+    return a.hsv888.h == b.hsv888.h && a.hsv888.s == b.hsv888.s && a.hsv888.v == b.hsv888.v;
+}
+
+static void cache_remove(uint8_t index) {
+    qp_internal_cache_entry_t *entry  = &cache_entries[index];
+    uint32_t                   length = entry->length;
+
+    // Move the pixel data of the following entries down over the removed one
+    memmove(qp_internal_cache_data(entry), qp_internal_cache_data(entry) + length, cache_used - entry->offset - length);
+    for (uint8_t i = index + 1; i < cache_count; ++i) {
+        cache_entries[i].offset -= length;
+        cache_entries[i - 1] = cache_entries[i];
+    }
+    cache_used -= length;
+    cache_count--;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Lookup and allocation
+
+qp_internal_cache_entry_t *qp_internal_cache_find(painter_device_t device, const void *asset, uint32_t key, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (uint8_t i = 0; i < cache_count; ++i) {
+        qp_internal_cache_entry_t *entry = &cache_entries[i];
+        if (entry->device == device && entry->asset == asset && entry->key == key && hsv888_equal(entry->fg_hsv888, fg_hsv888) && hsv888_equal(entry->bg_hsv888, bg_hsv888)) {
+            entry->last_used = ++cache_tick;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+qp_internal_cache_entry_t *qp_internal_cache_alloc(painter_device_t device, const void *asset, uint32_t key, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t pixel_count) {
+    struct painter_driver_t *driver = (struct painter_driver_t *)device;
+
+    // Keep each entry aligned, as drivers write native pixels wider than a byte directly
+    uint32_t length = ((pixel_count * driver->native_bits_per_pixel + 7) / 8 + 3) & ~3UL;
+    if (length > sizeof(cache_pool)) {
+        return NULL;
+    }
+
+    // Discard the least recently used entries until there's enough space
+    while (cache_count == QUANTUM_PAINTER_DECODE_CACHE_ENTRIES || cache_used + length > sizeof(cache_pool)) {
+        uint8_t lru = 0;
+        for (uint8_t i = 1; i < cache_count; ++i) {
+            if ((int32_t)(cache_entries[i].last_used - cache_entries[lru].last_used) < 0) {
+                lru = i;
+            }
+        }
+        cache_remove(lru);
+    }
+
+    qp_internal_cache_entry_t *entry = &cache_entries[cache_count++];
+    memset(entry, 0, sizeof(qp_internal_cache_entry_t));
+    entry->device    = device;
+    entry->asset     = asset;
+    entry->key       = key;
+    entry->fg_hsv888 = fg_hsv888;
+    entry->bg_hsv888 = bg_hsv888;
+    entry->offset    = cache_used;
+    entry->length    = length;
+    entry->last_used = ++cache_tick;
+    cache_used += length;
+    return entry;
+}
+
+void qp_internal_cache_invalidate(const void *asset) {
+    for (uint8_t i = 0; i < cache_count;) {
+        if (cache_entries[i].asset == asset) {
+            cache_remove(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Decoding and drawing
+
+struct qp_internal_cache_output_state {
+    painter_device_t device;
+    uint8_t *        target_buffer;
+    uint32_t         pixel_write_pos;
+};
+
+static bool qp_internal_cache_appender(qp_pixel_t *palette, uint8_t index, void *cb_arg) {
+    struct qp_internal_cache_output_state *state  = (struct qp_internal_cache_output_state *)cb_arg;
+    struct painter_driver_t *              driver = (struct painter_driver_t *)state->device;
+    return driver->driver_vtable->append_pixels(state->device, state->target_buffer, palette, state->pixel_write_pos++, 1, &index);
+}
+
+bool qp_internal_cache_fill(qp_internal_cache_entry_t *entry, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void *input_arg) {
+    struct qp_internal_cache_output_state output_state = {.device = entry->device, .target_buffer = qp_internal_cache_data(entry), .pixel_write_pos = 0};
+
+    uint32_t pixel_count = ((uint32_t)entry->width) * entry->height;
+    if (!qp_internal_decode_palette(entry->device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_internal_global_pixel_lookup_table, qp_internal_cache_appender, &output_state)) {
+        cache_remove(entry - cache_entries);
+        return false;
+    }
+    return true;
+}
+
+bool qp_internal_cache_blit(painter_device_t device, const qp_internal_cache_entry_t *entry, uint16_t x, uint16_t y) {
+    struct painter_driver_t *driver = (struct painter_driver_t *)device;
+    uint16_t                 l      = x + entry->left;
+    uint16_t                 t      = y + entry->top;
+    if (!driver->driver_vtable->viewport(device, l, t, l + entry->width - 1, t + entry->height - 1)) {
+        return false;
+    }
+    return driver->driver_vtable->pixdata(device, qp_internal_cache_data(entry), ((uint32_t)entry->width) * entry->height);
+}
+
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
@@ -95,6 +95,11 @@ bool qp_close_image(painter_image_handle_t image) {
         return false;
     }
 
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+    // Any cached frames now belong to nothing
+    qp_internal_cache_invalidate(qgf_image);
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+
     // Free up this image for use elsewhere.
     qgf_image->validate_ok = false;
     qp_stream_close(&qgf_image->stream);
@@ -219,12 +224,34 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+    // Frames already in the cache only need sending
+    qp_internal_cache_entry_t *entry = qp_internal_cache_find(device, qgf_image, frame_number, fg_hsv888, bg_hsv888);
+    if (entry) {
+        frame_info->delay = entry->delay;
+        if (!qp_comms_start(device)) {
+            qp_dprintf("qp_drawimage_recolor: fail (could not start comms)\n");
+            return false;
+        }
+        bool ret = qp_internal_cache_blit(device, entry, x, y);
+        qp_dprintf("qp_drawimage_recolor: %s (cached)\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ret;
+    }
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+
     // Read the frame info
     if (!qp_drawimage_prepare_frame_for_stream_read(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, frame_info)) {
         qp_dprintf("qp_drawimage_recolor: fail (could not read frame %d)\n", frame_number);
         return false;
     }
 
+    // Delta frames which are identical to the previous frame have nothing to draw
+    if (frame_info->is_delta && (frame_info->right <= frame_info->left || frame_info->bottom <= frame_info->top)) {
+        qp_dprintf("qp_drawimage_recolor: ok (unchanged frame)\n");
+        return true;
+    }
+
     if (!qp_comms_start(device)) {
         qp_dprintf("qp_drawimage_recolor: fail (could not start comms)\n");
         return false;
@@ -260,6 +287,22 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         return false;
     }
 
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+    // Decode into the cache if there's space, so that the next draw of this frame only needs sending
+    entry = qp_internal_cache_alloc(device, qgf_image, frame_number, fg_hsv888, bg_hsv888, pixel_count);
+    if (entry) {
+        entry->left   = l - x;
+        entry->top    = t - y;
+        entry->width  = r - l + 1;
+        entry->height = b - t + 1;
+        entry->delay  = frame_info->delay;
+        bool ret      = qp_internal_cache_fill(entry, frame_info->bpp, input_callback, &input_state) && driver->driver_vtable->pixdata(device, qp_internal_cache_data(entry), pixel_count);
+        qp_dprintf("qp_drawimage_recolor: %s\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        return ret;
+    }
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+
     // Set up the output state
     struct qp_internal_pixel_output_state output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
@@ -150,6 +150,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+    // Any cached glyphs now belong to nothing
+    qp_internal_cache_invalidate(qff_font);
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -162,6 +167,9 @@ bool qp_close_font(painter_font_handle_t font) {
 // Callback to be invoked for each codepoint detected in the UTF8 input string
 typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
 
+// Optional callback to be invoked before looking up each codepoint's glyph, returning true (and the width) if the lookup can be skipped
+typedef bool (*code_point_lookup)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width, void *cb_arg);
+
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
     struct painter_driver_t *driver = (struct painter_driver_t *)device;
@@ -292,7 +300,7 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
 }
 
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
-static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_handler handler, void *cb_arg) {
+static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const char *str, code_point_lookup lookup, code_point_handler handler, void *cb_arg) {
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
@@ -302,7 +310,9 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
         }
 
         uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        if (lookup && lookup(qff_font, code_point, &width, cb_arg)) {
+            // Glyph is already known, no need to touch the stream
+        } else if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
             qp_dprintf("Failed to prepare glyph for rendering.\n");
             return false;
         }
@@ -344,8 +354,51 @@ struct code_point_iter_drawglyph_state {
     qp_internal_byte_input_callback        input_callback;
     struct qp_internal_byte_input_state *  input_state;
     struct qp_internal_pixel_output_state *output_state;
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+    // Cache
+    qp_pixel_t                 fg_hsv888;
+    qp_pixel_t                 bg_hsv888;
+    bool                       palette_ready;
+    qp_internal_cache_entry_t *cache_entry;
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
 };
 
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+// Codepoint lookup callback: check the decode cache
+static inline bool qp_font_code_point_lookup_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width, void *cb_arg) {
+    struct code_point_iter_drawglyph_state *state = (struct code_point_iter_drawglyph_state *)cb_arg;
+
+    state->cache_entry = qp_internal_cache_find(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888);
+    if (state->cache_entry) {
+        *width = state->cache_entry->width;
+        return true;
+    }
+    return false;
+}
+
+// Decodes a glyph into the decode cache and draws it. Returns false in `*cached` if there was no space.
+static inline bool qp_font_code_point_cache_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, struct code_point_iter_drawglyph_state *state, bool *cached) {
+    // The palette is only set up once a glyph actually needs decoding -- it moves the stream, so locate the glyph again
+    if (!state->palette_ready) {
+        uint32_t data_offset;
+        if (!qp_drawtext_prepare_font_for_render(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &data_offset) || !qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+            return false;
+        }
+        state->palette_ready = true;
+    }
+
+    qp_internal_cache_entry_t *entry = qp_internal_cache_alloc(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888, ((uint32_t)width) * height);
+    *cached                          = entry != NULL;
+    if (!entry) {
+        return true;
+    }
+
+    entry->width  = width;
+    entry->height = height;
+    return qp_internal_cache_fill(entry, qff_font->bpp, state->input_callback, state->input_state) && qp_internal_cache_blit(state->device, entry, state->xpos, state->ypos);
+}
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+
 // Codepoint handler callback: drawing
 static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
     struct code_point_iter_drawglyph_state *state  = (struct code_point_iter_drawglyph_state *)cb_arg;
@@ -354,6 +407,22 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+    // Glyphs already in the cache only need sending
+    if (state->cache_entry) {
+        bool ret = qp_internal_cache_blit(state->device, state->cache_entry, state->xpos, state->ypos);
+        state->xpos += width;
+        return ret;
+    }
+
+    bool cached    = false;
+    bool cache_ret = qp_font_code_point_cache_drawglyph(qff_font, code_point, width, height, state, &cached);
+    if (!cache_ret || cached) {
+        state->xpos += width;
+        return cache_ret;
+    }
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+
     // Reset the output state
     state->output_state->pixel_write_pos = 0;
 
@@ -388,7 +457,7 @@ int16_t qp_textwidth(painter_font_handle_t font, const char *str) {
     // Create the codepoint iterator state
     struct code_point_iter_calcwidth_state state = {.width = 0};
     // Iterate each codepoint, return the calculated width if successful.
-    return qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_calcwidth, &state) ? state.width : 0;
+    return qp_iterate_code_points(qff_font, str, NULL, qp_font_code_point_handler_calcwidth, &state) ? state.width : 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -447,7 +516,16 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
 
     qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
     qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
+#if QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+    // The font is prepared for rendering once the first glyph missing from the cache is decoded
+    state.fg_hsv888     = fg_hsv888;
+    state.bg_hsv888     = bg_hsv888;
+    state.palette_ready = false;
+
+    // Iterate the codepoints with the drawglyph callback, skipping the glyph lookup for cached glyphs
+    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_lookup_drawglyph, qp_font_code_point_handler_drawglyph, &state);
+#else  // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
+    uint32_t data_offset;
     if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
         qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
         qp_comms_stop(device);
@@ -455,7 +533,8 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     }
 
     // Iterate the codepoints with the drawglyph callback
-    bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
+    bool ret = qp_iterate_code_points(qff_font, str, NULL, qp_font_code_point_handler_drawglyph, &state);
+#endif // QUANTUM_PAINTER_DECODE_CACHE_SIZE > 0
 
     qp_dprintf("qp_drawtext_recolor: %s\n", ret ? "ok" : "fail");
     qp_comms_stop(device);
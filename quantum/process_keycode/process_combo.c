@@ -18,6 +18,8 @@
 #include "process_combo.h"
 #include "action_tapping.h"
 #include "action.h"
+#include <stdlib.h>
+#include <string.h>
 
 #ifdef COMBO_COUNT
 __attribute__((weak)) combo_t key_combos[COMBO_COUNT];
@@ -88,6 +90,99 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#if defined(PROTOCOL_CHIBIOS) && !defined(COMBO_NO_INDEX)
+#    if CH_CFG_USE_MEMCORE == FALSE
+#        define COMBO_NO_INDEX
+#    endif
+#endif
+
+#ifndef COMBO_NO_INDEX
+/* Inverted index of all combo keys, sorted by keycode and then by combo index,
+ * so that each key event only visits the combos it is part of. Combos which
+ * were touched since they were last reset are tracked in combo_dirty, so that
+ * clear_combos() does not have to visit every combo either. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_key_entry_t;
+
+static bool               combo_keys_built = false;
+static combo_key_entry_t *combo_keys       = NULL;
+static uint16_t           combo_keys_size  = 0;
+static uint8_t *          combo_dirty      = NULL;
+
+static int combo_keys_compare(const void *a, const void *b) {
+    const combo_key_entry_t *entry_a = a;
+    const combo_key_entry_t *entry_b = b;
+
+    if (entry_a->keycode != entry_b->keycode) {
+        return entry_a->keycode < entry_b->keycode ? -1 : 1;
+    }
+    if (entry_a->combo_index != entry_b->combo_index) {
+        return entry_a->combo_index < entry_b->combo_index ? -1 : 1;
+    }
+    return 0;
+}
+
+static void combo_keys_build(void) {
+    combo_keys_built = true;
+
+    uint16_t size = 0;
+    for (uint16_t index = 0; index < COMBO_LEN; ++index) {
+        for (const uint16_t *keys = key_combos[index].keys; pgm_read_word(keys) != COMBO_END; keys++) {
+            size++;
+        }
+    }
+
+    // Falls back to visiting every combo if there is not enough memory
+    combo_keys  = malloc(size * sizeof(combo_key_entry_t));
+    combo_dirty = calloc((COMBO_LEN + 7) / 8, 1);
+    if (!combo_keys || !combo_dirty) {
+        free(combo_keys);
+        free(combo_dirty);
+        combo_keys  = NULL;
+        combo_dirty = NULL;
+        return;
+    }
+
+    combo_key_entry_t *entry = combo_keys;
+    for (uint16_t index = 0; index < COMBO_LEN; ++index) {
+        for (const uint16_t *keys = key_combos[index].keys; pgm_read_word(keys) != COMBO_END; keys++) {
+            *entry++ = (combo_key_entry_t){.keycode = pgm_read_word(keys), .combo_index = index};
+        }
+    }
+    qsort(combo_keys, size, sizeof(combo_key_entry_t), combo_keys_compare);
+
+    // A combo listing the same key twice must still only be processed once per event
+    combo_keys_size = 0;
+    for (uint16_t i = 0; i < size; i++) {
+        if (!combo_keys_size || memcmp(&combo_keys[combo_keys_size - 1], &combo_keys[i], sizeof(combo_key_entry_t))) {
+            combo_keys[combo_keys_size++] = combo_keys[i];
+        }
+    }
+}
+
+/* Returns the position of the first entry of keycode, or the position it would be inserted at. */
+static uint16_t combo_keys_find(uint16_t keycode) {
+    uint16_t low = 0, high = combo_keys_size;
+    while (low < high) {
+        uint16_t mid = low + (high - low) / 2;
+        if (combo_keys[mid].keycode < keycode) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static inline void combo_mark_dirty(uint16_t combo_index) {
+    if (combo_dirty) {
+        combo_dirty[combo_index / 8] |= 1 << (combo_index % 8);
+    }
+}
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -188,6 +283,26 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+#ifndef COMBO_NO_INDEX
+    if (combo_dirty) {
+        // Only combos which were touched since they were last reset need resetting
+        for (uint16_t byte = 0; byte < (COMBO_LEN + 7) / 8; ++byte) {
+            uint8_t dirty = combo_dirty[byte];
+            while (dirty) {
+                uint8_t bit = __builtin_ctz(dirty);
+                dirty &= dirty - 1;
+
+                index          = byte * 8 + bit;
+                combo_t *combo = &key_combos[index];
+                if (!COMBO_ACTIVE(combo)) {
+                    RESET_COMBO_STATE(combo);
+                    combo_dirty[byte] &= ~(1 << bit);
+                }
+            }
+        }
+        return;
+    }
+#endif
     for (index = 0; index < COMBO_LEN; ++index) {
         combo_t *combo = &key_combos[index];
         if (!COMBO_ACTIVE(combo)) {
@@ -417,6 +532,10 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
         return false;
     }
 
+#ifndef COMBO_NO_INDEX
+    combo_mark_dirty(combo_index);
+#endif
+
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
                                  && keys_pressed_in_order(combo_index, combo, key_index, keycode, record)
@@ -528,8 +647,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -551,10 +669,24 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     keycode = keymap_key_to_keycode(COMBO_ONLY_FROM_LAYER, record->event.key);
 #endif
 
-    for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
-        combo_t *combo = &key_combos[idx];
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifndef COMBO_NO_INDEX
+    if (!combo_keys_built) {
+        combo_keys_build();
+    }
+
+    // COMBO_END terminates every key list, so it is matched by every combo
+    if (combo_keys && keycode != COMBO_END) {
+        for (uint16_t i = combo_keys_find(keycode); i < combo_keys_size && combo_keys[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_keys[i].combo_index;
+            is_combo_key |= process_single_combo(&key_combos[idx], keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < COMBO_LEN; ++idx) {
+            combo_t *combo = &key_combos[idx];
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
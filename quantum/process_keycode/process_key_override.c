@@ -19,15 +19,26 @@
 #include "report.h"
 #include "timer.h"
 #include "process_key_override.h"
+#include "benchmark_probe.h"
 
 #include <debug.h>
+#include <string.h>
 
 #ifndef KEY_OVERRIDE_REPEAT_DELAY
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
-// For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
-// #define BENCH_KEY_OVERRIDE
+// Maximum number of overrides covered by the lookup index. Larger tables are searched linearly.
+#ifndef KEY_OVERRIDE_INDEX_SIZE
+#    if defined(__AVR__)
+#        define KEY_OVERRIDE_INDEX_SIZE 32
+#    else
+#        define KEY_OVERRIDE_INDEX_SIZE 255
+#    endif
+#endif
+
+// The index holds 8-bit positions, and its loops use 8-bit counters
+_Static_assert(KEY_OVERRIDE_INDEX_SIZE <= 255, "KEY_OVERRIDE_INDEX_SIZE must not be larger than 255");
 
 // For debug output (needs keyboard debugging enabled as well)
 // #define DEBUG_KEY_OVERRIDE
@@ -84,6 +95,125 @@ static bool enabled = true;
 // Public variables
 __attribute__((weak)) const key_override_t **key_overrides = NULL;
 
+// Lookup index
+
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+// Positions of the overrides in key_overrides, ordered by trigger and then by position, so that the overrides for a trigger can be found with a binary search
+static uint8_t override_index[KEY_OVERRIDE_INDEX_SIZE];
+#endif
+static uint8_t                override_index_count     = 0;
+static bool                   override_index_usable    = false;
+static const key_override_t **override_index_overrides = NULL;
+
+/** Builds the index for the current key_overrides table, if it hasn't been built yet. Returns false if the table doesn't fit, in which case it has to be searched linearly. */
+static bool key_override_index_update(void) {
+    if (override_index_overrides == key_overrides) {
+        return override_index_usable;
+    }
+
+    override_index_overrides = key_overrides;
+    override_index_count     = 0;
+    override_index_usable    = false;
+
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+    for (uint8_t i = 0; key_overrides[i] != NULL; i++) {
+        if (i == KEY_OVERRIDE_INDEX_SIZE) {
+            return false;
+        }
+
+        // Insertion sort, which keeps overrides with the same trigger in table order
+        const uint16_t trigger = key_overrides[i]->trigger;
+        uint8_t        pos     = override_index_count++;
+        while (pos > 0 && key_overrides[override_index[pos - 1]]->trigger > trigger) {
+            override_index[pos] = override_index[pos - 1];
+            pos--;
+        }
+        override_index[pos] = i;
+    }
+    override_index_usable = true;
+#endif
+
+    return override_index_usable;
+}
+
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+/** Returns the position in the index of the first override whose trigger is not less than (or, if `after` is set, greater than) `trigger`. */
+static uint8_t key_override_index_bound(const uint16_t trigger, const bool after) {
+    uint8_t lo = 0;
+    uint8_t hi = override_index_count;
+    while (lo < hi) {
+        const uint8_t  mid   = lo + (hi - lo) / 2;
+        const uint16_t other = key_overrides[override_index[mid]]->trigger;
+        if (other < trigger || (after && other == trigger)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+#endif
+
+// An override can only activate if its trigger is KC_NO, the keycode of the event, or the last non-mod key pressed down
+#define KEY_OVERRIDE_CANDIDATE_TRIGGERS 3
+
+typedef struct {
+    bool     linear;
+    uint16_t position; // Position in key_overrides, when searching linearly
+    uint8_t  next[KEY_OVERRIDE_CANDIDATE_TRIGGERS];
+    uint8_t  end[KEY_OVERRIDE_CANDIDATE_TRIGGERS];
+} key_override_candidates_t;
+
+static void key_override_candidates_init(key_override_candidates_t *candidates, const uint16_t keycode) {
+    memset(candidates, 0, sizeof(key_override_candidates_t));
+    candidates->linear = !key_override_index_update();
+
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+    if (candidates->linear) {
+        return;
+    }
+
+    // On a non-mod key down, last_key_down is the keycode of the event already
+    const uint16_t triggers[KEY_OVERRIDE_CANDIDATE_TRIGGERS] = {KC_NO, keycode, last_key_down};
+    for (uint8_t i = 0; i < KEY_OVERRIDE_CANDIDATE_TRIGGERS; i++) {
+        bool duplicate = false;
+        for (uint8_t j = 0; j < i; j++) {
+            duplicate |= triggers[j] == triggers[i];
+        }
+        if (!duplicate) {
+            candidates->next[i] = key_override_index_bound(triggers[i], false);
+            candidates->end[i]  = key_override_index_bound(triggers[i], true);
+        }
+    }
+#endif
+}
+
+/** Returns the next override that may activate for the event, in table order, or NULL once there are none left. */
+static const key_override_t *key_override_candidates_next(key_override_candidates_t *candidates) {
+    if (candidates->linear) {
+        const key_override_t *const override = key_overrides[candidates->position];
+        if (override != NULL) {
+            candidates->position++;
+        }
+        return override;
+    }
+
+#if KEY_OVERRIDE_INDEX_SIZE > 0
+    // Merge the candidates of each trigger back into table order
+    int8_t best = -1;
+    for (uint8_t i = 0; i < KEY_OVERRIDE_CANDIDATE_TRIGGERS; i++) {
+        if (candidates->next[i] < candidates->end[i] && (best < 0 || override_index[candidates->next[i]] < override_index[candidates->next[best]])) {
+            best = i;
+        }
+    }
+    if (best >= 0) {
+        return key_overrides[override_index[candidates->next[best]++]];
+    }
+#endif
+
+    return NULL;
+}
+
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
@@ -249,10 +379,13 @@ static bool try_activating_override(const uint16_t keycode, const uint8_t layer,
         return true;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    key_override_candidates_t candidates;
+    key_override_candidates_init(&candidates, keycode);
 
-        // End of array
+    for (;;) {
+        const key_override_t *const override = key_override_candidates_next(&candidates);
+
+        // No more overrides which may activate
         if (override == NULL) {
             break;
         }
@@ -263,6 +396,12 @@ static bool try_activating_override(const uint16_t keycode, const uint8_t layer,
             continue;
         }
 
+        // A modifier event only activates the overrides that modifier takes part in: as a necessary modifier going down, or a negative modifier going up
+        if (is_mod && override->trigger != keycode && ((key_down ? override->trigger_mods : override->negative_mod_mask) & MOD_BIT(keycode)) == 0) {
+            key_override_printf("Not activating override: Modifier not involved\n");
+            continue;
+        }
+
         // Check layer
         if ((override->layers & (1 << layer)) == 0) {
             key_override_printf("Not activating override: Not set to activate on pressed layer\n");
@@ -396,11 +535,7 @@ void key_override_task(void) {
     }
 }
 
-bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
-#ifdef BENCH_KEY_OVERRIDE
-    uint16_t start = timer_read();
-#endif
-
+static bool process_key_override_event(const uint16_t keycode, const keyrecord_t *const record) {
     const bool key_down = record->event.pressed;
     const bool is_mod   = IS_MOD(keycode);
 
@@ -510,11 +645,12 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
         }
     }
 
-#ifdef BENCH_KEY_OVERRIDE
-    uint16_t elapsed = timer_elapsed(start);
-
-    dprintf("Processing key overrides took: %u ms\n", elapsed);
-#endif
+    return send_key_action;
+}
 
+bool process_key_override(const uint16_t keycode, const keyrecord_t *const record) {
+    BENCHMARK_PROBE_ENTER(KEY_OVERRIDE);
+    const bool send_key_action = process_key_override_event(keycode, record);
+    BENCHMARK_PROBE_EXIT(KEY_OVERRIDE);
     return send_key_action;
 }
@@ -19,6 +19,10 @@
 #    include "process_leader.h"
 #    include <string.h>
 
+#    if __has_include("leader_data.h")
+#        include "leader_data.h"
+#    endif
+
 #    ifndef LEADER_TIMEOUT
 #        define LEADER_TIMEOUT 300
 #    endif
@@ -34,6 +38,129 @@ uint16_t leader_time = 0;
 uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
 uint8_t  leader_sequence_size = 0;
 
+#    ifdef LEADER_DICTIONARY_SIZE
+
+#        define LEADER_NODE_TERMINAL 0x01
+#        define LEADER_NODE_NONE 0xFFFF
+
+// Offset of the trie node matching the keys typed so far, or LEADER_NODE_NONE
+static uint16_t leader_node = LEADER_NODE_NONE;
+static bool     leader_timeout_seen;
+
+__attribute__((weak)) bool leader_dictionary_match(uint16_t keycode) {
+    return true;
+}
+
+static bool leader_node_is_terminal(uint16_t node) {
+    return pgm_read_byte(&leader_data[node]) & LEADER_NODE_TERMINAL;
+}
+
+/** \brief Gets the offset of the child count of a trie node, which follows the keycode index of terminal nodes.
+ */
+static uint16_t leader_node_children(uint16_t node) {
+    return node + (leader_node_is_terminal(node) ? 3 : 1);
+}
+
+/** \brief Finds the child of a trie node for the given keycode.
+ *
+ * \return The offset of the child node, or LEADER_NODE_NONE if there is none
+ */
+static uint16_t leader_node_child(uint16_t node, uint16_t keycode) {
+    if (keycode > 0xFF) {
+        return LEADER_NODE_NONE;
+    }
+
+    uint16_t pos   = leader_node_children(node);
+    uint8_t  count = pgm_read_byte(&leader_data[pos++]);
+    for (; count > 0; count--, pos += 3) {
+        if (pgm_read_byte(&leader_data[pos]) == keycode) {
+            return pgm_read_byte(&leader_data[pos + 1]) | (pgm_read_byte(&leader_data[pos + 2]) << 8);
+        }
+    }
+    return LEADER_NODE_NONE;
+}
+
+/** \brief Ends the leader sequence, sending the keycode of the dictionary entry that was matched.
+ */
+static void leader_dictionary_fire(uint16_t node) {
+    uint16_t index   = pgm_read_byte(&leader_data[node + 1]) | (pgm_read_byte(&leader_data[node + 2]) << 8);
+    uint16_t keycode = pgm_read_word(&leader_keycodes[index]);
+
+    leading     = false;
+    leader_node = LEADER_NODE_NONE;
+    if (leader_dictionary_match(keycode)) {
+        tap_code16(keycode);
+    }
+    leader_end();
+}
+
+/** \brief Advances the dictionary match by one key.
+ *
+ * \return true if the keys typed so far are still the start of a dictionary sequence
+ */
+static bool leader_dictionary_step(uint16_t keycode) {
+    if (leader_node != LEADER_NODE_NONE) {
+        leader_node = leader_node_child(leader_node, keycode);
+    }
+    leader_timeout_seen = false;
+    return leader_node != LEADER_NODE_NONE;
+}
+
+/** \brief Fires the matched dictionary entry right away when no longer sequence can follow it.
+ */
+static void leader_dictionary_fire_if_complete(void) {
+    if (leader_node != LEADER_NODE_NONE && !pgm_read_byte(&leader_data[leader_node_children(leader_node)])) {
+        leader_dictionary_fire(leader_node);
+    }
+}
+
+bool leader_dictionary_has_match(void) {
+    return leading && leader_node != LEADER_NODE_NONE && leader_node_is_terminal(leader_node);
+}
+
+void leader_task(void) {
+    if (!leading) {
+        return;
+    }
+
+#        ifdef LEADER_NO_TIMEOUT
+    if (leader_sequence_size == 0) {
+        return;
+    }
+#        endif
+    if (timer_elapsed(leader_time) <= LEADER_TIMEOUT) {
+        return;
+    }
+
+    if (leader_dictionary_has_match()) {
+        leader_dictionary_fire(leader_node);
+    } else if (leader_timeout_seen) {
+        // Nothing handled the sequence in LEADER_DICTIONARY() either
+        leading     = false;
+        leader_node = LEADER_NODE_NONE;
+        leader_end();
+    } else {
+        // Leave LEADER_DICTIONARY() one more scan to pick the sequence up, as it runs earlier in the loop
+        leader_timeout_seen = true;
+    }
+}
+
+#    else
+
+static bool leader_dictionary_step(uint16_t keycode) {
+    return false;
+}
+
+static void leader_dictionary_fire_if_complete(void) {}
+
+bool leader_dictionary_has_match(void) {
+    return false;
+}
+
+void leader_task(void) {}
+
+#    endif // LEADER_DICTIONARY_SIZE
+
 void qk_leader_start(void) {
     if (leading) {
         return;
@@ -43,6 +170,10 @@ void qk_leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#    ifdef LEADER_DICTIONARY_SIZE
+    leader_node         = 0;
+    leader_timeout_seen = false;
+#    endif
 }
 
 bool process_leader(uint16_t keycode, keyrecord_t *record) {
@@ -60,10 +191,12 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                     keycode = QK_LAYER_TAP_GET_TAP_KEYCODE(keycode);
                 }
 #    endif // LEADER_KEY_STRICT_KEY_PROCESSING
+                // Only the first keys are kept when matching the dictionary, as its sequences aren't limited in length
+                bool matching = leader_dictionary_step(keycode);
                 if (leader_sequence_size < ARRAY_SIZE(leader_sequence)) {
                     leader_sequence[leader_sequence_size] = keycode;
                     leader_sequence_size++;
-                } else {
+                } else if (!matching) {
                     leading = false;
                     leader_end();
                     return true;
@@ -71,6 +204,7 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
 #    ifdef LEADER_PER_KEY_TIMING
                 leader_time = timer_read();
 #    endif
+                leader_dictionary_fire_if_complete();
                 return false;
             }
         } else {
@@ -23,6 +23,21 @@ bool process_leader(uint16_t keycode, keyrecord_t *record);
 void leader_start(void);
 void leader_end(void);
 void qk_leader_start(void);
+void leader_task(void);
+
+/**
+ * \brief Called when a sequence from the generated leader dictionary is matched.
+ *
+ * \return false to skip tapping `keycode`
+ */
+bool leader_dictionary_match(uint16_t keycode);
+
+/**
+ * \brief Whether the keys typed so far match a sequence from the generated leader dictionary.
+ *
+ * Such sequences are left to the dictionary once the leader timeout expires, rather than to LEADER_DICTIONARY().
+ */
+bool leader_dictionary_has_match(void);
 
 #define SEQ_ONE_KEY(key) if (leader_sequence[0] == (key) && leader_sequence[1] == 0 && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
 #define SEQ_TWO_KEYS(key1, key2) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
@@ -37,7 +52,7 @@ void qk_leader_start(void);
     extern uint8_t  leader_sequence_size
 
 #ifdef LEADER_NO_TIMEOUT
-#    define LEADER_DICTIONARY() if (leading && leader_sequence_size > 0 && timer_elapsed(leader_time) > LEADER_TIMEOUT)
+#    define LEADER_DICTIONARY() if (leading && leader_sequence_size > 0 && timer_elapsed(leader_time) > LEADER_TIMEOUT && !leader_dictionary_has_match())
 #else
-#    define LEADER_DICTIONARY() if (leading && timer_elapsed(leader_time) > LEADER_TIMEOUT)
+#    define LEADER_DICTIONARY() if (leading && timer_elapsed(leader_time) > LEADER_TIMEOUT && !leader_dictionary_has_match())
 #endif
@@ -138,6 +138,11 @@ bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+// Rebuilds the per-LED geometry cache, must be called after g_led_config.point is changed at runtime
+void rgb_matrix_update_geometry(void);
+#endif
+
 void rgb_matrix_reload_from_eeprom(void);
 
 void        rgb_matrix_set_suspend_state(bool state);
@@ -254,10 +259,17 @@ static inline bool rgb_matrix_check_finished_leds(uint8_t led_idx) {
 
 extern const rgb_matrix_driver_t rgb_matrix_driver;
 
+/* Number of blocks of PWM registers written to the LED drivers by the last flush, for debugging.
+ * Always 0 for drivers which do not track changed LEDs. */
+uint16_t rgb_matrix_get_flush_blocks(void);
+
 extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+extern led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
@@ -33,6 +33,13 @@
 #        endif
 #    endif
 
+// Number of PWM register blocks written to the LED drivers by the last flush
+static uint16_t flush_blocks = 0;
+
+uint16_t rgb_matrix_get_flush_blocks(void) {
+    return flush_blocks;
+}
+
 static void init(void) {
     i2c_init();
 
@@ -202,13 +209,13 @@ static void init(void) {
 
 #    if defined(IS31FL3731)
 static void flush(void) {
-    IS31FL3731_update_pwm_buffers(DRIVER_ADDR_1, 0);
+    flush_blocks = IS31FL3731_update_pwm_buffers(DRIVER_ADDR_1, 0);
 #        if defined(DRIVER_ADDR_2)
-    IS31FL3731_update_pwm_buffers(DRIVER_ADDR_2, 1);
+    flush_blocks += IS31FL3731_update_pwm_buffers(DRIVER_ADDR_2, 1);
 #            if defined(DRIVER_ADDR_3)
-    IS31FL3731_update_pwm_buffers(DRIVER_ADDR_3, 2);
+    flush_blocks += IS31FL3731_update_pwm_buffers(DRIVER_ADDR_3, 2);
 #                if defined(DRIVER_ADDR_4)
-    IS31FL3731_update_pwm_buffers(DRIVER_ADDR_4, 3);
+    flush_blocks += IS31FL3731_update_pwm_buffers(DRIVER_ADDR_4, 3);
 #                endif
 #            endif
 #        endif
@@ -223,13 +230,13 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 #    elif defined(IS31FL3733)
 static void flush(void) {
-    IS31FL3733_update_pwm_buffers(DRIVER_ADDR_1, 0);
+    flush_blocks = IS31FL3733_update_pwm_buffers(DRIVER_ADDR_1, 0);
 #        if defined(DRIVER_ADDR_2)
-    IS31FL3733_update_pwm_buffers(DRIVER_ADDR_2, 1);
+    flush_blocks += IS31FL3733_update_pwm_buffers(DRIVER_ADDR_2, 1);
 #            if defined(DRIVER_ADDR_3)
-    IS31FL3733_update_pwm_buffers(DRIVER_ADDR_3, 2);
+    flush_blocks += IS31FL3733_update_pwm_buffers(DRIVER_ADDR_3, 2);
 #                if defined(DRIVER_ADDR_4)
-    IS31FL3733_update_pwm_buffers(DRIVER_ADDR_4, 3);
+    flush_blocks += IS31FL3733_update_pwm_buffers(DRIVER_ADDR_4, 3);
 #                endif
 #            endif
 #        endif
@@ -244,13 +251,13 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 #    elif defined(IS31FL3737)
 static void flush(void) {
-    IS31FL3737_update_pwm_buffers(DRIVER_ADDR_1, 0);
+    flush_blocks = IS31FL3737_update_pwm_buffers(DRIVER_ADDR_1, 0);
 #        if defined(DRIVER_ADDR_2)
-    IS31FL3737_update_pwm_buffers(DRIVER_ADDR_2, 1);
+    flush_blocks += IS31FL3737_update_pwm_buffers(DRIVER_ADDR_2, 1);
 #            if defined(DRIVER_ADDR_3)
-    IS31FL3737_update_pwm_buffers(DRIVER_ADDR_3, 2);
+    flush_blocks += IS31FL3737_update_pwm_buffers(DRIVER_ADDR_3, 2);
 #                if defined(DRIVER_ADDR_4)
-    IS31FL3737_update_pwm_buffers(DRIVER_ADDR_4, 3);
+    flush_blocks += IS31FL3737_update_pwm_buffers(DRIVER_ADDR_4, 3);
 #                endif
 #            endif
 #        endif
@@ -265,9 +272,9 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 #    elif defined(IS31FL3741)
 static void flush(void) {
-    IS31FL3741_update_pwm_buffers(DRIVER_ADDR_1, 0);
+    flush_blocks = IS31FL3741_update_pwm_buffers(DRIVER_ADDR_1, 0);
 #        if defined(DRIVER_ADDR_2)
-    IS31FL3741_update_pwm_buffers(DRIVER_ADDR_2, 1);
+    flush_blocks += IS31FL3741_update_pwm_buffers(DRIVER_ADDR_2, 1);
 #        endif
 }
 
@@ -280,13 +287,13 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 #    elif defined(IS31FLCOMMON)
 static void flush(void) {
-    IS31FL_common_update_pwm_register(DRIVER_ADDR_1, 0);
+    flush_blocks = IS31FL_common_update_pwm_register(DRIVER_ADDR_1, 0);
 #        if defined(DRIVER_ADDR_2)
-    IS31FL_common_update_pwm_register(DRIVER_ADDR_2, 1);
+    flush_blocks += IS31FL_common_update_pwm_register(DRIVER_ADDR_2, 1);
 #            if defined(DRIVER_ADDR_3)
-    IS31FL_common_update_pwm_register(DRIVER_ADDR_3, 2);
+    flush_blocks += IS31FL_common_update_pwm_register(DRIVER_ADDR_3, 2);
 #                if defined(DRIVER_ADDR_4)
-    IS31FL_common_update_pwm_register(DRIVER_ADDR_4, 3);
+    flush_blocks += IS31FL_common_update_pwm_register(DRIVER_ADDR_4, 3);
 #                endif
 #            endif
 #        endif
@@ -301,13 +308,13 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 #    elif defined(CKLED2001)
 static void flush(void) {
-    CKLED2001_update_pwm_buffers(DRIVER_ADDR_1, 0);
+    flush_blocks = CKLED2001_update_pwm_buffers(DRIVER_ADDR_1, 0);
 #        if defined(DRIVER_ADDR_2)
-    CKLED2001_update_pwm_buffers(DRIVER_ADDR_2, 1);
+    flush_blocks += CKLED2001_update_pwm_buffers(DRIVER_ADDR_2, 1);
 #            if defined(DRIVER_ADDR_3)
-    CKLED2001_update_pwm_buffers(DRIVER_ADDR_3, 2);
+    flush_blocks += CKLED2001_update_pwm_buffers(DRIVER_ADDR_3, 2);
 #                if defined(DRIVER_ADDR_4)
-    CKLED2001_update_pwm_buffers(DRIVER_ADDR_4, 3);
+    flush_blocks += CKLED2001_update_pwm_buffers(DRIVER_ADDR_4, 3);
 #                endif
 #            endif
 #        endif
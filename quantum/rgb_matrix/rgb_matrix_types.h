@@ -64,6 +64,12 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+// Distance and angle of an LED from k_rgb_matrix_center, as computed by sqrt16() and atan2_8()
+typedef struct PACKED {
+    uint8_t dist;
+    uint8_t angle;
+} led_geometry_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -0,0 +1,18 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 1
+#define MATRIX_COLS 2
+
+#define RGB_MATRIX_LED_COUNT 2
+#define DRIVER_COUNT 1
+#define DRIVER_ADDR_1 0x74
+
+// The IS31FL3731 PWM registers start at 0x24, the others at 0x00
+#ifdef IS31FL3731
+#    define TEST_PWM_REGISTER(reg) (0x24 + (reg))
+#else
+#    define TEST_PWM_REGISTER(reg) (reg)
+#endif
@@ -0,0 +1,14 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+
+// One LED in the first block of PWM registers, the other in the third
+#ifdef CKLED2001
+const ckled2001_led PROGMEM g_ckled2001_leds[RGB_MATRIX_LED_COUNT] = {
+#else
+const is31_led PROGMEM g_is31_leds[RGB_MATRIX_LED_COUNT] = {
+#endif
+    {0, TEST_PWM_REGISTER(0x00), TEST_PWM_REGISTER(0x01), TEST_PWM_REGISTER(0x02)},
+    {0, TEST_PWM_REGISTER(0x20), TEST_PWM_REGISTER(0x21), TEST_PWM_REGISTER(0x22)},
+};
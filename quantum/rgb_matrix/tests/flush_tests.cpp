@@ -0,0 +1,85 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "i2c_master.h"
+}
+
+class RgbMatrixFlush : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // Start out with every register written and nothing left to flush
+        rgb_matrix_driver.set_color_all(0, 0, 0);
+        rgb_matrix_driver.flush();
+        mock_i2c_reset();
+    }
+
+    void flush(void) {
+        rgb_matrix_driver.flush();
+    }
+
+    bool led_is(uint8_t reg, uint8_t red, uint8_t green, uint8_t blue) {
+        return mock_i2c_registers[TEST_PWM_REGISTER(reg)] == red && mock_i2c_registers[TEST_PWM_REGISTER(reg + 1)] == green && mock_i2c_registers[TEST_PWM_REGISTER(reg + 2)] == blue;
+    }
+};
+
+TEST_F(RgbMatrixFlush, UnchangedFrameWritesNothing) {
+    rgb_matrix_driver.set_color_all(0, 0, 0);
+    flush();
+    EXPECT_EQ(rgb_matrix_get_flush_blocks(), 0);
+    EXPECT_EQ(mock_i2c_pwm_blocks(), 0);
+}
+
+TEST_F(RgbMatrixFlush, WritesOnlyChangedBlocks) {
+    rgb_matrix_driver.set_color(1, 10, 20, 30);
+    flush();
+    EXPECT_EQ(rgb_matrix_get_flush_blocks(), 1);
+    EXPECT_EQ(mock_i2c_pwm_blocks(), 1);
+    EXPECT_TRUE(led_is(0x20, 10, 20, 30));
+
+    // Setting the same colour again leaves nothing to write
+    rgb_matrix_driver.set_color(1, 10, 20, 30);
+    flush();
+    EXPECT_EQ(rgb_matrix_get_flush_blocks(), 0);
+    EXPECT_EQ(mock_i2c_pwm_blocks(), 1);
+}
+
+TEST_F(RgbMatrixFlush, CountsEveryChangedBlock) {
+    rgb_matrix_driver.set_color(0, 1, 2, 3);
+    rgb_matrix_driver.set_color(1, 4, 5, 6);
+    flush();
+    EXPECT_EQ(rgb_matrix_get_flush_blocks(), 2);
+    EXPECT_EQ(mock_i2c_pwm_blocks(), 2);
+    EXPECT_TRUE(led_is(0x00, 1, 2, 3));
+    EXPECT_TRUE(led_is(0x20, 4, 5, 6));
+}
+
+TEST_F(RgbMatrixFlush, FailedBlockIsSentAgain) {
+    rgb_matrix_driver.set_color(0, 1, 2, 3);
+    rgb_matrix_driver.set_color(1, 4, 5, 6);
+    mock_i2c_fail_register(TEST_PWM_REGISTER(0x00));
+    flush();
+    uint16_t written = rgb_matrix_get_flush_blocks();
+#ifdef I2C_ASYNC_ENABLE
+    // Queued blocks are counted as written, whether or not their transfer succeeds later on
+    EXPECT_EQ(written, 2);
+    EXPECT_LT(mock_i2c_pwm_blocks(), 2);
+#else
+    EXPECT_LT(written, 2);
+    EXPECT_EQ(written, mock_i2c_pwm_blocks());
+#endif
+    EXPECT_FALSE(led_is(0x00, 1, 2, 3));
+
+    // Nothing changed in between, but the blocks which were not transferred are still dirty
+    mock_i2c_fail_register(-1);
+    flush();
+    EXPECT_EQ(mock_i2c_pwm_blocks(), 2);
+    EXPECT_TRUE(led_is(0x00, 1, 2, 3));
+    EXPECT_TRUE(led_is(0x20, 4, 5, 6));
+
+    flush();
+    EXPECT_EQ(rgb_matrix_get_flush_blocks(), 0);
+}
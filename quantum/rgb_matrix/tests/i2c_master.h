@@ -0,0 +1,32 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout);
+
+#ifdef I2C_ASYNC_ENABLE
+// Queued transfers are carried out straight away, before their callback is called
+typedef void (*i2c_async_callback_t)(i2c_status_t status, void* context);
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context);
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context);
+#endif
+
+// Registers of the mocked LED driver, as written by successful transfers
+extern uint8_t mock_i2c_registers[256];
+
+// Number of PWM register blocks of 16 bytes written by the successful transfers
+uint16_t mock_i2c_pwm_blocks(void);
+// Makes the transfers starting at the given register fail, or none if negative
+void mock_i2c_fail_register(int16_t reg);
+void mock_i2c_reset(void);
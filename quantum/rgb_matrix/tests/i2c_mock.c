@@ -0,0 +1,56 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "i2c_master.h"
+
+uint8_t mock_i2c_registers[256];
+
+static uint16_t pwm_blocks   = 0;
+static int16_t  fail_register = -1;
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    if (data[0] == fail_register) {
+        return I2C_STATUS_TIMEOUT;
+    }
+    memcpy(&mock_i2c_registers[data[0]], &data[1], length - 1);
+    // Anything but single register writes is a transfer of PWM register blocks
+    if (length > 2) {
+        pwm_blocks += (length - 1) / 16;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+#ifdef I2C_ASYNC_ENABLE
+i2c_status_t i2c_transmit_async(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context) {
+    i2c_status_t status = i2c_transmit(address, data, length, timeout);
+    if (callback) {
+        callback(status, context);
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg_async(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout, i2c_async_callback_t callback, void* context) {
+    uint8_t buffer[length + 1];
+    buffer[0] = regaddr;
+    memcpy(&buffer[1], data, length);
+    return i2c_transmit_async(devaddr, buffer, length + 1, timeout, callback, context);
+}
+#endif
+
+uint16_t mock_i2c_pwm_blocks(void) {
+    return pwm_blocks;
+}
+
+void mock_i2c_fail_register(int16_t reg) {
+    fail_register = reg;
+}
+
+void mock_i2c_reset(void) {
+    memset(mock_i2c_registers, 0, sizeof(mock_i2c_registers));
+    pwm_blocks    = 0;
+    fail_register = -1;
+}
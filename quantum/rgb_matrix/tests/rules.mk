@@ -0,0 +1,52 @@
+rgb_matrix_flush_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/i2c_mock.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/flush_leds.c \
+	$(QUANTUM_PATH)/rgb_matrix/tests/flush_tests.cpp \
+	$(QUANTUM_PATH)/rgb_matrix/rgb_matrix_drivers.c
+rgb_matrix_flush_INC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests \
+	$(QUANTUM_PATH)/rgb_matrix \
+	$(QUANTUM_PATH)/rgb_matrix/animations \
+	$(DRIVER_PATH)/led \
+	$(DRIVER_PATH)/led/issi
+
+rgb_matrix_flush_is31fl3731_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DIS31FL3731
+rgb_matrix_flush_is31fl3731_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_flush.h
+rgb_matrix_flush_is31fl3731_INC := $(rgb_matrix_flush_INC)
+rgb_matrix_flush_is31fl3731_SRC := $(rgb_matrix_flush_SRC) $(DRIVER_PATH)/led/issi/is31fl3731.c
+
+rgb_matrix_flush_is31fl3733_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DIS31FL3733
+rgb_matrix_flush_is31fl3733_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_flush.h
+rgb_matrix_flush_is31fl3733_INC := $(rgb_matrix_flush_INC)
+rgb_matrix_flush_is31fl3733_SRC := $(rgb_matrix_flush_SRC) $(DRIVER_PATH)/led/issi/is31fl3733.c
+
+rgb_matrix_flush_is31fl3737_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DIS31FL3737
+rgb_matrix_flush_is31fl3737_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_flush.h
+rgb_matrix_flush_is31fl3737_INC := $(rgb_matrix_flush_INC)
+rgb_matrix_flush_is31fl3737_SRC := $(rgb_matrix_flush_SRC) $(DRIVER_PATH)/led/issi/is31fl3737.c
+
+rgb_matrix_flush_ckled2001_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DCKLED2001
+rgb_matrix_flush_ckled2001_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_flush.h
+rgb_matrix_flush_ckled2001_INC := $(rgb_matrix_flush_INC)
+rgb_matrix_flush_ckled2001_SRC := $(rgb_matrix_flush_SRC) $(DRIVER_PATH)/led/ckled2001.c
+
+rgb_matrix_flush_async_is31fl3731_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DIS31FL3731 -DI2C_ASYNC_ENABLE
+rgb_matrix_flush_async_is31fl3731_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_flush.h
+rgb_matrix_flush_async_is31fl3731_INC := $(rgb_matrix_flush_INC)
+rgb_matrix_flush_async_is31fl3731_SRC := $(rgb_matrix_flush_SRC) $(DRIVER_PATH)/led/issi/is31fl3731.c
+
+rgb_matrix_flush_async_is31fl3733_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DIS31FL3733 -DI2C_ASYNC_ENABLE
+rgb_matrix_flush_async_is31fl3733_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_flush.h
+rgb_matrix_flush_async_is31fl3733_INC := $(rgb_matrix_flush_INC)
+rgb_matrix_flush_async_is31fl3733_SRC := $(rgb_matrix_flush_SRC) $(DRIVER_PATH)/led/issi/is31fl3733.c
+
+rgb_matrix_flush_async_is31fl3737_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DIS31FL3737 -DI2C_ASYNC_ENABLE
+rgb_matrix_flush_async_is31fl3737_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_flush.h
+rgb_matrix_flush_async_is31fl3737_INC := $(rgb_matrix_flush_INC)
+rgb_matrix_flush_async_is31fl3737_SRC := $(rgb_matrix_flush_SRC) $(DRIVER_PATH)/led/issi/is31fl3737.c
+
+rgb_matrix_flush_async_ckled2001_DEFS := -DNO_DEBUG -DRGB_MATRIX_ENABLE -DCKLED2001 -DI2C_ASYNC_ENABLE
+rgb_matrix_flush_async_ckled2001_CONFIG := $(QUANTUM_PATH)/rgb_matrix/tests/config_flush.h
+rgb_matrix_flush_async_ckled2001_INC := $(rgb_matrix_flush_INC)
+rgb_matrix_flush_async_ckled2001_SRC := $(rgb_matrix_flush_SRC) $(DRIVER_PATH)/led/ckled2001.c
@@ -0,0 +1,9 @@
+TEST_LIST += \
+	rgb_matrix_flush_is31fl3731 \
+	rgb_matrix_flush_is31fl3733 \
+	rgb_matrix_flush_is31fl3737 \
+	rgb_matrix_flush_ckled2001 \
+	rgb_matrix_flush_async_is31fl3731 \
+	rgb_matrix_flush_async_is31fl3733 \
+	rgb_matrix_flush_async_is31fl3737 \
+	rgb_matrix_flush_async_ckled2001
@@ -23,6 +23,11 @@
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include <string.h>
+#    include "action_util.h"
+#    include "timer.h"
+#endif
 
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
@@ -143,9 +148,6 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 
 // clang-format on
 
-// Note: we bit-pack in "reverse" order to optimize loading
-#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
-
 void send_string(const char *string) {
     send_string_with_delay(string, 0);
 }
@@ -326,3 +328,233 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     }
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+
+// Minimum time between two reports sent by the asynchronous engine
+#    ifndef SEND_STRING_ASYNC_INTERVAL
+#        ifdef USB_POLLING_INTERVAL_MS
+#            define SEND_STRING_ASYNC_INTERVAL USB_POLLING_INTERVAL_MS
+#        else
+#            define SEND_STRING_ASYNC_INTERVAL 1
+#        endif
+#    endif
+
+// Number of strings which can be waiting to be typed out at once
+#    ifndef SEND_STRING_ASYNC_PENDING
+#        define SEND_STRING_ASYNC_PENDING 4
+#    endif
+
+// Each queued operation is either the press or release of a keycode, or a delay in milliseconds
+#    define SS_ASYNC_OP_PRESS 0x0000
+#    define SS_ASYNC_OP_RELEASE 0x4000
+#    define SS_ASYNC_OP_DELAY 0x8000
+#    define SS_ASYNC_OP_TYPE_MASK 0xC000
+#    define SS_ASYNC_OP_VALUE_MASK 0x3FFF
+
+// A single character expands to at most modifiers, the tap itself, the dead key space tap and the interval
+#    define SS_ASYNC_QUEUE_SIZE 12
+
+typedef struct {
+    const char *         string;
+    send_string_reader_t reader;
+    uint8_t              interval;
+} send_string_async_source_t;
+
+static send_string_async_source_t async_sources[SEND_STRING_ASYNC_PENDING];
+static uint8_t                    async_source_count = 0;
+static uint16_t                   async_queue[SS_ASYNC_QUEUE_SIZE];
+static uint8_t                    async_queue_head  = 0;
+static uint8_t                    async_queue_count = 0;
+static uint32_t                   async_last_report = 0;
+static uint32_t                   async_wait        = 0;
+static uint8_t                    async_mods        = 0;     // held by the engine, apart from the ones held by the user
+static bool                       async_mods_hidden = false; // the user's modifiers were left out of the last report
+
+static void async_push(uint16_t op) {
+    async_queue[(async_queue_head + async_queue_count) % SS_ASYNC_QUEUE_SIZE] = op;
+    async_queue_count++;
+}
+
+static void async_push_delay(uint16_t ms) {
+    if (ms) {
+        async_push(SS_ASYNC_OP_DELAY | (ms > SS_ASYNC_OP_VALUE_MASK ? SS_ASYNC_OP_VALUE_MASK : ms));
+    }
+}
+
+static void async_push_tap(uint8_t keycode) {
+    async_push(SS_ASYNC_OP_PRESS | keycode);
+    async_push_delay(keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY);
+    async_push(SS_ASYNC_OP_RELEASE | keycode);
+}
+
+// Same sequence of keycodes as send_char()
+static void async_push_char(char ascii_code) {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') { // BEL
+        PLAY_SONG(bell_song);
+        return;
+    }
+#    endif
+
+    uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+    bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+    bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+    bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+    if (is_shifted) {
+        async_push(SS_ASYNC_OP_PRESS | KC_LEFT_SHIFT);
+    }
+    if (is_altgred) {
+        async_push(SS_ASYNC_OP_PRESS | KC_RIGHT_ALT);
+    }
+    async_push_tap(keycode);
+    if (is_altgred) {
+        async_push(SS_ASYNC_OP_RELEASE | KC_RIGHT_ALT);
+    }
+    if (is_shifted) {
+        async_push(SS_ASYNC_OP_RELEASE | KC_LEFT_SHIFT);
+    }
+    if (is_dead) {
+        async_push_tap(KC_SPACE);
+    }
+}
+
+/**
+ * Queues the operations of the next character or sequence of the oldest pending string, returning false once the end
+ * of the string has been reached.
+ */
+static bool async_parse_next(send_string_async_source_t *source) {
+    char ascii_code = source->reader(source->string);
+    if (!ascii_code) {
+        return false;
+    }
+    if (ascii_code == SS_QMK_PREFIX) {
+        ascii_code = source->reader(++source->string);
+        if (ascii_code == SS_TAP_CODE || ascii_code == SS_DOWN_CODE || ascii_code == SS_UP_CODE) {
+            uint8_t keycode = source->reader(++source->string);
+            if (!keycode) {
+                return false;
+            }
+            if (ascii_code == SS_TAP_CODE) {
+                async_push_tap(keycode);
+            } else {
+                async_push((ascii_code == SS_DOWN_CODE ? SS_ASYNC_OP_PRESS : SS_ASYNC_OP_RELEASE) | keycode);
+            }
+        } else if (ascii_code == SS_DELAY_CODE) {
+            uint16_t ms      = 0;
+            uint8_t  keycode = source->reader(++source->string);
+            while (isdigit(keycode)) {
+                ms = ms * 10 + (keycode - '0');
+                if (ms > SS_ASYNC_OP_VALUE_MASK) {
+                    ms = SS_ASYNC_OP_VALUE_MASK;
+                }
+                keycode = source->reader(++source->string);
+            }
+            if (!keycode) {
+                return false;
+            }
+            async_push_delay(ms);
+        } else if (!ascii_code) {
+            return false;
+        }
+    } else {
+        async_push_char(ascii_code);
+    }
+    ++source->string;
+    async_push_delay(source->interval);
+    return true;
+}
+
+static bool async_refill(void) {
+    while (async_source_count) {
+        if (async_parse_next(&async_sources[0])) {
+            return true;
+        }
+        memmove(&async_sources[0], &async_sources[1], --async_source_count * sizeof(send_string_async_source_t));
+    }
+    return false;
+}
+
+void send_string_async_task(void) {
+    while (async_queue_count || async_refill()) {
+        uint16_t op = async_queue[async_queue_head];
+
+        // Delays are added on top of the interval since the last report
+        if ((op & SS_ASYNC_OP_TYPE_MASK) != SS_ASYNC_OP_DELAY && timer_elapsed32(async_last_report) < async_wait) {
+            return;
+        }
+        async_queue_head = (async_queue_head + 1) % SS_ASYNC_QUEUE_SIZE;
+        async_queue_count--;
+
+        if ((op & SS_ASYNC_OP_TYPE_MASK) == SS_ASYNC_OP_DELAY) {
+            async_wait += op & SS_ASYNC_OP_VALUE_MASK;
+            continue;
+        }
+
+        // Swap in the engine's own modifiers, so that its keys neither pick up nor drop the ones the user is holding
+        const uint8_t mods      = get_mods();
+        const uint8_t weak_mods = get_weak_mods();
+        set_mods(async_mods);
+        clear_weak_mods();
+        if ((op & SS_ASYNC_OP_TYPE_MASK) == SS_ASYNC_OP_PRESS) {
+            register_code(op & 0xFF);
+        } else {
+            unregister_code(op & 0xFF);
+        }
+        async_mods = get_mods();
+        set_mods(mods);
+        set_weak_mods(weak_mods);
+        async_mods_hidden |= mods || weak_mods;
+
+        async_last_report = timer_read32();
+        async_wait        = SEND_STRING_ASYNC_INTERVAL;
+
+        // Parse ahead, so that finished strings are no longer reported as busy
+        if (!async_queue_count) {
+            async_refill();
+        }
+        return;
+    }
+
+    // Once done, report the modifiers the user is holding again
+    if (async_mods_hidden && timer_elapsed32(async_last_report) >= async_wait) {
+        async_mods_hidden = false;
+        send_keyboard_report();
+        async_last_report = timer_read32();
+        async_wait        = SEND_STRING_ASYNC_INTERVAL;
+    }
+}
+
+bool send_string_async_is_busy(void) {
+    return async_source_count || async_queue_count || async_mods_hidden;
+}
+
+void send_string_with_reader_async(const char *string, uint8_t interval, send_string_reader_t reader) {
+    // Fall back to blocking until one of the pending strings has been typed out
+    while (async_source_count == SEND_STRING_ASYNC_PENDING) {
+        send_string_async_task();
+        wait_ms(1);
+    }
+    async_sources[async_source_count++] = (send_string_async_source_t){.string = string, .reader = reader, .interval = interval};
+}
+
+static char async_read_ram(const char *p) {
+    return *p;
+}
+
+void send_string_with_delay_async(const char *string, uint8_t interval) {
+    send_string_with_reader_async(string, interval, async_read_ram);
+}
+
+#    if defined(__AVR__)
+static char async_read_progmem(const char *p) {
+    return pgm_read_byte(p);
+}
+
+void send_string_with_delay_async_P(const char *string, uint8_t interval) {
+    send_string_with_reader_async(string, interval, async_read_progmem);
+}
+#    endif
+
+#endif // SEND_STRING_ASYNC_ENABLE
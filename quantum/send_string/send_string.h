@@ -22,6 +22,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include "progmem.h"
 #include "send_string_keycodes.h"
@@ -44,6 +45,9 @@ extern const uint8_t ascii_to_keycode_lut[128];
     | ((h) ? 1 : 0) << 7 )
 // clang-format on
 
+// Reads bit `pos` of a table packed with KCLUT_ENTRY. Note: we bit-pack in "reverse" order to optimize loading
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
 /**
  * \brief Type out a string of ASCII characters.
  *
@@ -149,4 +153,65 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Reads the byte at `p` of a string that is being typed out asynchronously.
+ */
+typedef char (*send_string_reader_t)(const char *p);
+
+/**
+ * \brief Type out a string of ASCII characters, without blocking.
+ *
+ * The string is typed out by send_string_async_task() from the main loop, at most one report every
+ * `SEND_STRING_ASYNC_INTERVAL` milliseconds, while the keyboard keeps scanning. The string must remain valid until it
+ * has been typed out. If strings are already waiting to be typed out, it is typed out after them.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_with_delay_async(const char *string, uint8_t interval);
+
+/**
+ * \brief Type out a string of ASCII characters using `reader` to access it, without blocking.
+ *
+ * This allows strings stored outside of RAM, such as in EEPROM, to be typed out asynchronously.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ * \param reader Function used to read each byte of the string.
+ */
+void send_string_with_reader_async(const char *string, uint8_t interval, send_string_reader_t reader);
+
+/**
+ * \brief Returns true if there are still strings being typed out asynchronously.
+ */
+bool send_string_async_is_busy(void);
+
+/**
+ * \brief Sends the next queued report of the strings being typed out asynchronously, when it is due.
+ *
+ * Called once per main loop iteration.
+ */
+void send_string_async_task(void);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Type out a PROGMEM string of ASCII characters, with a delay between each character, without blocking.
+ *
+ * On ARM devices, this function is simply an alias for send_string_with_delay_async(string, interval).
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait before typing the next character.
+ */
+void send_string_with_delay_async_P(const char *string, uint8_t interval);
+#    else
+#        define send_string_with_delay_async_P(string, interval) send_string_with_delay_async(string, interval)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_with_delay_async_P(PSTR(string), 0).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_with_delay_async_P(PSTR(string), 0)
+#endif
+
 /** \} */
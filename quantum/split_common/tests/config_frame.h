@@ -0,0 +1,12 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 4
+#define MATRIX_COLS 2
+
+#define SPLIT_TRANSPORT_COALESCE
+#define SPLIT_TRANSPORT_MIRROR
+
+#define FORCED_SYNC_THROTTLE_MS 100
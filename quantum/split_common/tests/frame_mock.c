@@ -0,0 +1,153 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "transactions.h"
+#include "transport.h"
+#include "transaction_id_define.h"
+#include "tests/frame_mock.h"
+
+// Both halves live in this process, the shared memory in use is swapped for the half that runs
+static split_coalesced_memory_t slave_memory;
+static bool                     running_slave = false;
+
+static uint8_t  serial_fail      = 0;
+static uint8_t  serial_corrupt[] = {0, 0};
+static uint16_t serial_count     = 0;
+static uint32_t frame_mask[]     = {0, 0};
+static uint8_t  frame_size[]     = {0, 0};
+
+static void swap_memory(void) {
+    static split_coalesced_memory_t other;
+    memcpy(&other, split_shmem, sizeof(other));
+    memcpy(split_shmem, &slave_memory, sizeof(other));
+    memcpy(&slave_memory, &other, sizeof(other));
+}
+
+bool is_keyboard_master(void) {
+    return !running_slave;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+// Frames only go over the wire up to the length in their header, as with the serial protocol
+static uint8_t wire_size(int sstd_index, const uint8_t *buffer, uint8_t size) {
+    if (sstd_index == EXCHANGE_FRAME) {
+        return split_frame_size((const split_frame_t *)buffer);
+    }
+    return size;
+}
+
+bool soft_serial_transaction(int sstd_index) {
+    serial_count++;
+    if (serial_fail) {
+        serial_fail--;
+        return false;
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[sstd_index];
+    uint8_t                   m2s[trans->initiator2target_buffer_size + 1];
+    uint8_t                   s2m[trans->target2initiator_buffer_size + 1];
+
+    // Only the buffers of the transaction go over the wire
+    uint8_t m2s_size = wire_size(sstd_index, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    memcpy(m2s, split_trans_initiator2target_buffer(trans), m2s_size);
+    if (serial_corrupt[0] && m2s_size) {
+        serial_corrupt[0]--;
+        m2s[m2s_size - 1] ^= 0x01;
+    }
+
+    swap_memory();
+    running_slave = true;
+    memcpy(split_trans_initiator2target_buffer(trans), m2s, m2s_size);
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+    uint8_t s2m_size = wire_size(sstd_index, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size);
+    memcpy(s2m, split_trans_target2initiator_buffer(trans), s2m_size);
+    running_slave = false;
+    swap_memory();
+
+    if (serial_corrupt[1] && s2m_size) {
+        serial_corrupt[1]--;
+        s2m[s2m_size - 1] ^= 0x01;
+    }
+    memcpy(split_trans_target2initiator_buffer(trans), s2m, s2m_size);
+
+    if (sstd_index == EXCHANGE_FRAME) {
+        frame_mask[0] = ((const split_frame_t *)m2s)->mask;
+        frame_mask[1] = ((const split_frame_t *)s2m)->mask;
+        frame_size[0] = m2s_size;
+        frame_size[1] = s2m_size;
+    }
+    return true;
+}
+
+void mock_slave_scan(matrix_row_t row) {
+    matrix_row_t slave_matrix[(MATRIX_ROWS) / 2] = {row};
+    mock_slave_scan_rows(slave_matrix);
+}
+
+void mock_slave_scan_rows(matrix_row_t slave_matrix[]) {
+    matrix_row_t master_matrix[(MATRIX_ROWS) / 2] = {0};
+
+    swap_memory();
+    running_slave = true;
+    transactions_slave(master_matrix, slave_matrix);
+    running_slave = false;
+    swap_memory();
+}
+
+matrix_row_t mock_slave_master_row(void) {
+    return slave_memory.shmem.mmatrix.matrix[0];
+}
+
+uint32_t mock_slave_sync_timer(void) {
+    return slave_memory.shmem.sync_timer;
+}
+
+void mock_serial_fail(uint8_t count) {
+    serial_fail = count;
+}
+
+void mock_serial_corrupt_m2s(uint8_t count) {
+    serial_corrupt[0] = count;
+}
+
+void mock_serial_corrupt_s2m(uint8_t count) {
+    serial_corrupt[1] = count;
+}
+
+uint16_t mock_serial_transactions(void) {
+    return serial_count;
+}
+
+uint32_t mock_frame_m2s_mask(void) {
+    return frame_mask[0];
+}
+
+uint32_t mock_frame_s2m_mask(void) {
+    return frame_mask[1];
+}
+
+uint8_t mock_frame_m2s_size(void) {
+    return frame_size[0];
+}
+
+uint8_t mock_frame_s2m_size(void) {
+    return frame_size[1];
+}
+
+void mock_frame_reset(void) {
+    serial_fail       = 0;
+    serial_corrupt[0] = 0;
+    serial_corrupt[1] = 0;
+    serial_count      = 0;
+}
@@ -0,0 +1,26 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "transport.h"
+
+// Runs the slave half of a scan against the slave's own copy of the shared memory
+void mock_slave_scan(matrix_row_t row);
+void mock_slave_scan_rows(matrix_row_t slave_matrix[]);
+// Master matrix and sync timer as last received by the slave, before its next scan applies them
+matrix_row_t mock_slave_master_row(void);
+uint32_t     mock_slave_sync_timer(void);
+
+// Fails the next `count` serial transactions outright
+void mock_serial_fail(uint8_t count);
+// Flips a bit in the next `count` frames sent by the master, or replied by the slave
+void mock_serial_corrupt_m2s(uint8_t count);
+void mock_serial_corrupt_s2m(uint8_t count);
+// Serial transactions run so far, and the region masks and sizes on the wire of the last frames sent each way
+uint16_t mock_serial_transactions(void);
+uint32_t mock_frame_m2s_mask(void);
+uint32_t mock_frame_s2m_mask(void);
+uint8_t  mock_frame_m2s_size(void);
+uint8_t  mock_frame_s2m_size(void);
+void     mock_frame_reset(void);
@@ -0,0 +1,51 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "transactions.h"
+#include "transport.h"
+#include "tests/mock.h"
+
+#define MOCK_SERIAL_PUSHES 8
+
+split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
+
+static split_slave_matrix_push_t serial_pushes[MOCK_SERIAL_PUSHES];
+static uint8_t                   serial_push_count = 0;
+
+void mock_serial_push(uint16_t time, matrix_row_t row) {
+    split_slave_matrix_push_t *push = &serial_pushes[serial_push_count++];
+    memset(push, 0, sizeof(*push));
+    push->time      = time;
+    push->matrix[0] = row;
+}
+
+void mock_serial_reset(void) {
+    serial_push_count = 0;
+}
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    return true;
+}
+
+void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int sstd_index) {
+    return true;
+}
+
+bool soft_serial_push(const split_slave_matrix_push_t *push) {
+    return true;
+}
+
+void soft_serial_receive_pushes(void) {
+    for (uint8_t i = 0; i < serial_push_count; i++) {
+        transport_push_received(&serial_pushes[i]);
+    }
+    serial_push_count = 0;
+}
@@ -0,0 +1,10 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "transport.h"
+
+// Queues a frame as received by the serial driver, handed over when the master asks for pushes
+void mock_serial_push(uint16_t time, matrix_row_t row);
+void mock_serial_reset(void);
@@ -0,0 +1,21 @@
+split_transport_push_DEFS := -DNO_DEBUG -DSPLIT_KEYBOARD -DSPLIT_MATRIX_PUSH
+split_transport_push_INC := $(QUANTUM_PATH)/split_common
+split_transport_push_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_transport.h
+
+split_transport_push_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/mock.c \
+	$(QUANTUM_PATH)/split_common/tests/transport_push_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transport.c
+
+split_transport_frame_DEFS := -DNO_DEBUG -DSPLIT_KEYBOARD -DSERIAL_DRIVER_USART
+split_transport_frame_INC := $(QUANTUM_PATH)/split_common
+split_transport_frame_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_frame.h
+
+split_transport_frame_SRC := \
+	$(QUANTUM_PATH)/split_common/tests/frame_mock.c \
+	$(QUANTUM_PATH)/split_common/tests/transport_frame_tests.cpp \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/transport.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	platforms/test/timer.c
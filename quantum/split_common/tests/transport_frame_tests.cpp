@@ -0,0 +1,155 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "transport.h"
+#include "timer.h"
+#include "crc.h"
+#include "tests/frame_mock.h"
+
+void advance_time(uint32_t ms);
+}
+
+class TransportFrame : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[(MATRIX_ROWS) / 2] = {0};
+    matrix_row_t slave_matrix[(MATRIX_ROWS) / 2]  = {0};
+
+    void SetUp() override {
+        transport_master_init();
+        mock_frame_reset();
+
+        // Start from a full sync, whatever the previous test left behind
+        advance_time(FORCED_SYNC_THROTTLE_MS);
+        ASSERT_TRUE(scan(0));
+        ASSERT_TRUE(scan(0));
+        mock_frame_reset();
+    }
+
+    bool scan(matrix_row_t slave_row) {
+        mock_slave_scan(slave_row);
+        advance_time(1);
+        return transport_master(master_matrix, slave_matrix);
+    }
+};
+
+TEST_F(TransportFrame, MasterStateGoesOutWithTheSameScan) {
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    master_matrix[0] = 0b10;
+    ASSERT_TRUE(scan(0));
+    EXPECT_EQ(mock_serial_transactions(), 1);
+    EXPECT_EQ(mock_slave_master_row(), 0b10);
+    // The sync timer is sent with its fixed offset for the transfer
+    EXPECT_EQ(mock_slave_sync_timer(), timer_read32() + 2);
+}
+
+TEST_F(TransportFrame, SlaveMatrixComesBackWithTheSameScan) {
+    ASSERT_TRUE(scan(0b01));
+    EXPECT_EQ(slave_matrix[0], 0b01);
+    ASSERT_TRUE(scan(0b00));
+    EXPECT_EQ(slave_matrix[0], 0b00);
+}
+
+TEST_F(TransportFrame, OnlyChangedRegionsAreSent) {
+    ASSERT_TRUE(scan(0));
+    EXPECT_EQ(mock_frame_m2s_mask(), 0);
+    EXPECT_EQ(mock_frame_s2m_mask(), 0);
+
+    master_matrix[0] = 0b01;
+    ASSERT_TRUE(scan(0));
+    EXPECT_NE(mock_frame_m2s_mask(), 0);
+    EXPECT_EQ(mock_frame_s2m_mask(), 0);
+
+    ASSERT_TRUE(scan(0b10));
+    EXPECT_EQ(mock_frame_m2s_mask(), 0);
+    EXPECT_NE(mock_frame_s2m_mask(), 0);
+
+    ASSERT_TRUE(scan(0b10));
+    EXPECT_EQ(mock_frame_m2s_mask(), 0);
+    EXPECT_EQ(mock_frame_s2m_mask(), 0);
+}
+
+TEST_F(TransportFrame, OnlyChangedRegionsGoOverTheWire) {
+    ASSERT_TRUE(scan(0));
+    EXPECT_EQ(mock_frame_m2s_size(), SPLIT_FRAME_HEADER_SIZE);
+    EXPECT_EQ(mock_frame_s2m_size(), SPLIT_FRAME_HEADER_SIZE);
+
+    master_matrix[0] = 0b01;
+    ASSERT_TRUE(scan(0));
+    EXPECT_EQ(mock_frame_m2s_size(), SPLIT_FRAME_HEADER_SIZE + sizeof(split_master_matrix_sync_t));
+    EXPECT_EQ(mock_frame_s2m_size(), SPLIT_FRAME_HEADER_SIZE);
+
+    // The slave matrix and its checksum
+    ASSERT_TRUE(scan(0b10));
+    EXPECT_EQ(mock_frame_m2s_size(), SPLIT_FRAME_HEADER_SIZE);
+    EXPECT_EQ(mock_frame_s2m_size(), SPLIT_FRAME_HEADER_SIZE + sizeof(split_slave_matrix_sync_t));
+}
+
+TEST_F(TransportFrame, ChangeWithTheSameChecksumIsSent) {
+    // Find another slave matrix with the same crc8
+    matrix_row_t before[(MATRIX_ROWS) / 2] = {0b01};
+    matrix_row_t after[(MATRIX_ROWS) / 2]  = {0};
+    for (uint32_t value = 1; value <= UINT16_MAX; value++) {
+        after[0] = value & 0xFF;
+        after[1] = value >> 8;
+        if (memcmp(after, before, sizeof(after)) != 0 && crc8(after, sizeof(after)) == crc8(before, sizeof(before))) {
+            break;
+        }
+    }
+    ASSERT_EQ(crc8(after, sizeof(after)), crc8(before, sizeof(before)));
+
+    mock_slave_scan_rows(before);
+    advance_time(1);
+    ASSERT_TRUE(transport_master(master_matrix, slave_matrix));
+    EXPECT_EQ(slave_matrix[0], before[0]);
+
+    mock_slave_scan_rows(after);
+    advance_time(1);
+    ASSERT_TRUE(transport_master(master_matrix, slave_matrix));
+    EXPECT_NE(mock_frame_s2m_mask(), 0);
+    EXPECT_EQ(slave_matrix[0], after[0]);
+    EXPECT_EQ(slave_matrix[1], after[1]);
+}
+
+TEST_F(TransportFrame, UnchangedRegionsAreResyncedPeriodically) {
+    ASSERT_TRUE(scan(0));
+    EXPECT_EQ(mock_frame_s2m_mask(), 0);
+
+    advance_time(FORCED_SYNC_THROTTLE_MS);
+    ASSERT_TRUE(scan(0));
+    EXPECT_NE(mock_frame_m2s_mask(), 0);
+    EXPECT_NE(mock_frame_s2m_mask(), 0);
+}
+
+TEST_F(TransportFrame, CorruptedFrameIsRetried) {
+    mock_serial_corrupt_m2s(1);
+    master_matrix[0] = 0b11;
+    ASSERT_TRUE(scan(0));
+    EXPECT_EQ(mock_serial_transactions(), 2);
+    EXPECT_EQ(mock_slave_master_row(), 0b11);
+}
+
+TEST_F(TransportFrame, CorruptedReplyIsRetried) {
+    mock_serial_corrupt_s2m(1);
+    ASSERT_TRUE(scan(0b10));
+    EXPECT_EQ(mock_serial_transactions(), 2);
+    EXPECT_EQ(slave_matrix[0], 0b10);
+}
+
+TEST_F(TransportFrame, FailedFrameKeepsStagedRegions) {
+    mock_serial_fail(UINT8_MAX);
+    master_matrix[0] = 0b01;
+    EXPECT_FALSE(scan(0b01));
+    EXPECT_EQ(mock_serial_transactions(), 10);
+    EXPECT_EQ(mock_slave_master_row(), 0b00);
+    EXPECT_EQ(slave_matrix[0], 0b00);
+
+    // The master matrix is unchanged since it was staged, but still goes out once the slave is back
+    mock_serial_fail(0);
+    ASSERT_TRUE(scan(0b01));
+    EXPECT_EQ(mock_slave_master_row(), 0b01);
+    EXPECT_EQ(slave_matrix[0], 0b01);
+}
@@ -0,0 +1,69 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "transport.h"
+#include "tests/mock.h"
+}
+
+class TransportPush : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        split_slave_matrix_push_t push;
+        while (transport_receive_push(&push)) {
+        }
+        mock_serial_reset();
+    }
+};
+
+TEST_F(TransportPush, NothingPushed) {
+    split_slave_matrix_push_t push;
+    EXPECT_FALSE(transport_receive_push(&push));
+}
+
+TEST_F(TransportPush, PressAndReleaseWithinOneScan) {
+    // Both frames arrive before the master gets around to look at them
+    mock_serial_push(10, 0b01);
+    mock_serial_push(12, 0b00);
+
+    split_slave_matrix_push_t push;
+    ASSERT_TRUE(transport_receive_push(&push));
+    EXPECT_EQ(push.time, 10);
+    EXPECT_EQ(push.matrix[0], 0b01);
+
+    ASSERT_TRUE(transport_receive_push(&push));
+    EXPECT_EQ(push.time, 12);
+    EXPECT_EQ(push.matrix[0], 0b00);
+
+    EXPECT_FALSE(transport_receive_push(&push));
+}
+
+TEST_F(TransportPush, FullQueueDropsOldest) {
+    for (uint16_t i = 1; i <= SPLIT_MATRIX_PUSH_QUEUE_SIZE + 1; i++) {
+        mock_serial_push(i, i);
+    }
+
+    split_slave_matrix_push_t push;
+    for (uint16_t i = 2; i <= SPLIT_MATRIX_PUSH_QUEUE_SIZE + 1; i++) {
+        ASSERT_TRUE(transport_receive_push(&push));
+        EXPECT_EQ(push.time, i);
+    }
+    EXPECT_FALSE(transport_receive_push(&push));
+}
+
+TEST_F(TransportPush, KeepsOrderAcrossDrains) {
+    mock_serial_push(1, 0b01);
+
+    split_slave_matrix_push_t push;
+    ASSERT_TRUE(transport_receive_push(&push));
+    EXPECT_EQ(push.time, 1);
+
+    mock_serial_push(2, 0b11);
+    mock_serial_push(3, 0b10);
+    ASSERT_TRUE(transport_receive_push(&push));
+    EXPECT_EQ(push.time, 2);
+    ASSERT_TRUE(transport_receive_push(&push));
+    EXPECT_EQ(push.time, 3);
+}
@@ -43,8 +43,20 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#ifdef SPLIT_TRANSPORT_COALESCE
+#    if defined(USE_I2C) || !(defined(SERIAL_DRIVER_USART) || defined(SERIAL_DRIVER_VENDOR))
+#        error "SPLIT_TRANSPORT_COALESCE requires SERIAL_DRIVER = usart or vendor"
+#    endif
+
+static bool stage_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
+
+// Synced regions are staged locally and exchanged once per scan by the frame transaction
+#    define transport_write(id, data, length) stage_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) stage_transaction(id, NULL, 0, data, length)
+#else // SPLIT_TRANSPORT_COALESCE
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#endif // SPLIT_TRANSPORT_COALESCE
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -136,11 +148,75 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_MATRIX_PUSH
+#    if defined(USE_I2C) || !defined(SERIAL_DRIVER_USART) || !defined(SERIAL_USART_FULL_DUPLEX)
+#        error "SPLIT_MATRIX_PUSH requires SERIAL_DRIVER = usart with SERIAL_USART_FULL_DUPLEX"
+#    endif
+
+static uint16_t slave_matrix_push_time = 0; // sync timer of the slave when it pushed the current matrix, 0 if polled
+
+static inline uint8_t slave_matrix_push_checksum(const split_slave_matrix_push_t *push) {
+    return crc8((const uint8_t *)push + sizeof(push->checksum), sizeof(*push) - sizeof(push->checksum));
+}
+
+static bool slave_matrix_receive_push(void) {
+    split_slave_matrix_push_t push;
+    if (!transport_receive_push(&push) || push.checksum != slave_matrix_push_checksum(&push)) {
+        return false;
+    }
+
+    // Keep the shared memory in line, so that the next poll doesn't fetch the same matrix again
+    memcpy(split_shmem->smatrix.matrix, push.matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+#    ifndef DISABLE_SYNC_TIMER
+    slave_matrix_push_time = push.time;
+#    endif // DISABLE_SYNC_TIMER
+    return true;
+}
+
+static void slave_matrix_push(matrix_row_t slave_matrix[]) {
+    static matrix_row_t last_pushed[(MATRIX_ROWS) / 2] = {0};
+    if (memcmp(last_pushed, slave_matrix, sizeof(last_pushed)) == 0) {
+        return;
+    }
+
+    split_slave_matrix_push_t push;
+    memcpy(push.matrix, slave_matrix, sizeof(push.matrix));
+    push.time     = sync_timer_read() | 1;
+    push.checksum = slave_matrix_push_checksum(&push);
+    if (transport_push(&push)) {
+        memcpy(last_pushed, slave_matrix, sizeof(last_pushed));
+    }
+}
+
+uint16_t matrix_event_time(uint8_t row, uint16_t scan_time) {
+    const uint8_t slave_rows = isLeftHand ? (MATRIX_ROWS) / 2 : 0;
+    if (!slave_matrix_push_time || row < slave_rows || row >= slave_rows + (MATRIX_ROWS) / 2) {
+        return scan_time;
+    }
+    // Distrust anything but a recent timestamp, e.g. from before the sync timer was first synced
+    if (TIMER_DIFF_16(scan_time, slave_matrix_push_time) >= FORCED_SYNC_THROTTLE_MS) {
+        return scan_time;
+    }
+    return slave_matrix_push_time;
+}
+#endif // SPLIT_MATRIX_PUSH
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
     matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
 
+#ifdef SPLIT_MATRIX_PUSH
+    // A pushed matrix is already in, no need to poll the slave for it
+    if (slave_matrix_receive_push()) {
+        memcpy(last_matrix, split_shmem->smatrix.matrix, sizeof(last_matrix));
+        memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+        return true;
+    }
+    slave_matrix_push_time = 0;
+#endif // SPLIT_MATRIX_PUSH
+
     bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
     if (okay) {
         // Checksum matches the received data, save as the last matrix state
@@ -158,7 +234,15 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 
 // clang-format off
 #define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#ifdef SPLIT_MATRIX_PUSH
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE()                 \
+        do {                                                  \
+            TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix); \
+            slave_matrix_push(slave_matrix);                  \
+        } while (0)
+#else // SPLIT_MATRIX_PUSH
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#endif // SPLIT_MATRIX_PUSH
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
@@ -748,6 +832,195 @@ static void watchdog_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #endif // defined(SPLIT_WATCHDOG_ENABLE)
 
+////////////////////////////////////////////////////
+// Coalesced frame
+
+#ifdef SPLIT_TRANSPORT_COALESCE
+
+#    define SPLIT_FRAME_ACK (1 << 0)  // the previous frame from the other side was received intact
+#    define SPLIT_FRAME_FULL (1 << 1) // master requests every slave region, not just the changed ones
+
+_Static_assert(sizeof(split_frame_t) <= UINT8_MAX, "Too many synced regions for SPLIT_TRANSPORT_COALESCE");
+
+// PUT regions written by the master since the slave last acknowledged a frame
+static uint32_t staged_mask = 0;
+
+static bool stage_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    // Anything outside the synced regions, i.e. RPC, still runs as its own transaction
+    if (id >= EXCHANGE_FRAME) {
+        return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+        staged_mask |= (1UL << id);
+    }
+
+    // The local copy is as recent as the last frame received from the slave
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
+
+static inline uint8_t frame_region(int8_t id, bool m2s, uint8_t **buffer) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (m2s) {
+        *buffer = split_trans_initiator2target_buffer(trans);
+        return trans->initiator2target_buffer_size;
+    }
+    *buffer = split_trans_target2initiator_buffer(trans);
+    return trans->target2initiator_buffer_size;
+}
+
+static inline uint8_t frame_checksum(const split_frame_t *frame) {
+    return crc8(&frame->flags, split_frame_size(frame) - sizeof(frame->checksum));
+}
+
+// Only the regions set in `mask` are copied into the frame, back to back in the order of their transaction ids
+static void frame_pack(split_frame_t *frame, bool m2s, uint8_t flags, uint32_t mask) {
+    uint8_t length = 0;
+    for (int8_t id = 0; id < EXCHANGE_FRAME; id++) {
+        uint8_t *buffer;
+        uint8_t  size = frame_region(id, m2s, &buffer);
+        if (size && (mask & (1UL << id))) {
+            memcpy(&frame->data[length], buffer, size);
+            length += size;
+        }
+    }
+
+    frame->flags    = flags;
+    frame->mask     = mask;
+    frame->length   = length;
+    frame->checksum = frame_checksum(frame);
+}
+
+static bool frame_unpack(const split_frame_t *frame, bool m2s, uint8_t buffer_size) {
+    if (split_frame_size(frame) > buffer_size || frame->checksum != frame_checksum(frame)) {
+        return false;
+    }
+
+    // The regions in the mask have to add up to the length, before any of them is applied
+    uint8_t length = 0;
+    for (int8_t id = 0; id < EXCHANGE_FRAME; id++) {
+        uint8_t *buffer;
+        uint8_t  size = frame_region(id, m2s, &buffer);
+        if (frame->mask & (1UL << id)) {
+            length += size;
+        }
+    }
+    if (length != frame->length) {
+        return false;
+    }
+
+    uint8_t offset = 0;
+    for (int8_t id = 0; id < EXCHANGE_FRAME; id++) {
+        uint8_t *buffer;
+        uint8_t  size = frame_region(id, m2s, &buffer);
+        if (size && (frame->mask & (1UL << id))) {
+            memcpy(buffer, &frame->data[offset], size);
+            offset += size;
+        }
+    }
+    return true;
+}
+
+void transactions_frame_init(void) {
+    uint8_t m2s_length = SPLIT_FRAME_HEADER_SIZE;
+    uint8_t s2m_length = SPLIT_FRAME_HEADER_SIZE;
+    for (int8_t id = 0; id < EXCHANGE_FRAME; id++) {
+        m2s_length += split_transaction_table[id].initiator2target_buffer_size;
+        s2m_length += split_transaction_table[id].target2initiator_buffer_size;
+    }
+
+    split_transaction_table[EXCHANGE_FRAME].initiator2target_buffer_size = m2s_length;
+    split_transaction_table[EXCHANGE_FRAME].target2initiator_buffer_size = s2m_length;
+}
+
+static bool frame_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t last_full = 0;
+    static uint8_t  flags     = SPLIT_FRAME_FULL;
+
+    split_transaction_desc_t *trans = &split_transaction_table[EXCHANGE_FRAME];
+    split_frame_t            *m2s   = (split_frame_t *)split_trans_initiator2target_buffer(trans);
+    split_frame_t            *s2m   = (split_frame_t *)split_trans_target2initiator_buffer(trans);
+
+    if (timer_elapsed32(last_full) >= FORCED_SYNC_THROTTLE_MS) {
+        flags |= SPLIT_FRAME_FULL;
+    }
+
+    uint32_t sent = staged_mask;
+    frame_pack(m2s, true, flags, sent);
+    bool received = transport_execute_transaction(EXCHANGE_FRAME, NULL, 0, NULL, 0) && frame_unpack(s2m, false, trans->target2initiator_buffer_size);
+    bool acked    = received && (s2m->flags & SPLIT_FRAME_ACK);
+
+    // Staged regions are kept until the slave confirms it has applied them
+    if (acked) {
+        staged_mask &= ~sent;
+    }
+    if (received && (flags & SPLIT_FRAME_FULL)) {
+        last_full = timer_read32();
+    }
+    flags = received ? SPLIT_FRAME_ACK : SPLIT_FRAME_FULL;
+    return acked;
+}
+
+static void slave_frame_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static uint8_t  shadow[SPLIT_FRAME_DATA_SIZE]; // GET regions as last compared, back to back
+    static uint32_t pending   = 0;                 // GET regions changed since the master last acknowledged them
+    static uint32_t last_sent = 0;
+
+    const split_frame_t *m2s   = (const split_frame_t *)initiator2target_buffer;
+    split_frame_t       *s2m   = (split_frame_t *)target2initiator_buffer;
+    uint8_t              flags = 0;
+    bool                 full  = true;
+
+    if (frame_unpack(m2s, true, initiator2target_buffer_size)) {
+        flags = SPLIT_FRAME_ACK;
+        full  = m2s->flags & SPLIT_FRAME_FULL;
+        if (m2s->flags & SPLIT_FRAME_ACK) {
+            pending &= ~last_sent;
+        }
+    }
+
+    uint32_t regions = 0;
+    uint8_t  offset  = 0;
+    for (int8_t id = 0; id < EXCHANGE_FRAME; id++) {
+        uint8_t *buffer;
+        uint8_t  size = frame_region(id, false, &buffer);
+        if (!size) {
+            continue;
+        }
+
+        if (memcmp(&shadow[offset], buffer, size) != 0) {
+            memcpy(&shadow[offset], buffer, size);
+            pending |= (1UL << id);
+        }
+        regions |= (1UL << id);
+        offset += size;
+    }
+
+    last_sent = full ? regions : pending;
+    frame_pack(s2m, false, flags, last_sent);
+}
+
+// clang-format off
+#    define TRANSACTIONS_FRAME_MASTER() TRANSACTION_HANDLER_MASTER(frame)
+#    define TRANSACTIONS_FRAME_REGISTRATIONS \
+    [EXCHANGE_FRAME] = {0, offsetof(split_coalesced_memory_t, m2s_frame), 0, offsetof(split_coalesced_memory_t, s2m_frame), slave_frame_callback},
+// clang-format on
+
+#else // SPLIT_TRANSPORT_COALESCE
+
+#    define TRANSACTIONS_FRAME_MASTER()
+#    define TRANSACTIONS_FRAME_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_COALESCE
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -775,6 +1048,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_ST7565_REGISTRATIONS
     TRANSACTIONS_POINTING_REGISTRATIONS
     TRANSACTIONS_WATCHDOG_REGISTRATIONS
+    TRANSACTIONS_FRAME_REGISTRATIONS
 // clang-format on
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -786,6 +1060,27 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 };
 
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSPORT_COALESCE
+    // Everything for the slave is staged first so it goes out with this scan's frame, the sync timer last so it is
+    // as fresh as possible. Reads only see the slave once the frame is in, pointing CPI changes follow a scan later.
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_LAYER_STATE_MASTER();
+    TRANSACTIONS_LED_STATE_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_BACKLIGHT_MASTER();
+    TRANSACTIONS_RGBLIGHT_MASTER();
+    TRANSACTIONS_LED_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_ST7565_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_SYNC_TIMER_MASTER();
+    TRANSACTIONS_FRAME_MASTER();
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+#else  // SPLIT_TRANSPORT_COALESCE
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -802,6 +1097,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_ST7565_MASTER();
     TRANSACTIONS_POINTING_MASTER();
     TRANSACTIONS_WATCHDOG_MASTER();
+#endif // SPLIT_TRANSPORT_COALESCE
     return true;
 }
 
@@ -90,13 +90,24 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
 #    include "serial.h"
 
+#    ifdef SPLIT_TRANSPORT_COALESCE
+static split_coalesced_memory_t shared_memory;
+split_shared_memory_t *const    split_shmem = &shared_memory.shmem;
+#    else  // SPLIT_TRANSPORT_COALESCE
 static split_shared_memory_t shared_memory;
 split_shared_memory_t *const split_shmem = &shared_memory;
+#    endif // SPLIT_TRANSPORT_COALESCE
 
 void transport_master_init(void) {
+#    ifdef SPLIT_TRANSPORT_COALESCE
+    transactions_frame_init();
+#    endif // SPLIT_TRANSPORT_COALESCE
     soft_serial_initiator_init();
 }
 void transport_slave_init(void) {
+#    ifdef SPLIT_TRANSPORT_COALESCE
+    transactions_frame_init();
+#    endif // SPLIT_TRANSPORT_COALESCE
     soft_serial_target_init();
 }
 
@@ -119,6 +130,45 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    ifdef SPLIT_MATRIX_PUSH
+
+#        ifndef SPLIT_MATRIX_PUSH_QUEUE_SIZE
+#            define SPLIT_MATRIX_PUSH_QUEUE_SIZE 4
+#        endif // SPLIT_MATRIX_PUSH_QUEUE_SIZE
+
+_Static_assert(SPLIT_MATRIX_PUSH_QUEUE_SIZE > 0 && SPLIT_MATRIX_PUSH_QUEUE_SIZE <= 128, "SPLIT_MATRIX_PUSH_QUEUE_SIZE must be between 1 and 128");
+
+static split_slave_matrix_push_t push_queue[SPLIT_MATRIX_PUSH_QUEUE_SIZE];
+static uint8_t                   push_queue_head  = 0;
+static uint8_t                   push_queue_count = 0;
+
+bool transport_push(const split_slave_matrix_push_t *push) {
+    return soft_serial_push(push);
+}
+
+void transport_push_received(const split_slave_matrix_push_t *push) {
+    if (push_queue_count == SPLIT_MATRIX_PUSH_QUEUE_SIZE) {
+        // Drop the oldest frame, every frame carries the whole matrix so only intermediate states are lost
+        push_queue_head = (push_queue_head + 1) % SPLIT_MATRIX_PUSH_QUEUE_SIZE;
+        push_queue_count--;
+    }
+    memcpy(&push_queue[(push_queue_head + push_queue_count) % SPLIT_MATRIX_PUSH_QUEUE_SIZE], push, sizeof(*push));
+    push_queue_count++;
+}
+
+bool transport_receive_push(split_slave_matrix_push_t *push) {
+    soft_serial_receive_pushes();
+    if (!push_queue_count) {
+        return false;
+    }
+
+    memcpy(push, &push_queue[push_queue_head], sizeof(*push));
+    push_queue_head = (push_queue_head + 1) % SPLIT_MATRIX_PUSH_QUEUE_SIZE;
+    push_queue_count--;
+    return true;
+}
+#    endif // SPLIT_MATRIX_PUSH
+
 #endif // USE_I2C
 
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
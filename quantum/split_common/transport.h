@@ -18,6 +18,7 @@
 
 #include "stdint.h"
 #include "stdbool.h"
+#include "stddef.h"
 
 #include "progmem.h"
 #include "action_layer.h"
@@ -57,6 +58,21 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_MATRIX_PUSH
+typedef struct __attribute__((packed)) _split_slave_matrix_push_t {
+    uint8_t      checksum;
+    uint16_t     time;
+    matrix_row_t matrix[(MATRIX_ROWS) / 2];
+} split_slave_matrix_push_t;
+
+// slave sends its matrix as soon as it changes, instead of waiting for the master to poll it
+bool transport_push(const split_slave_matrix_push_t *push);
+// queues a frame received from the slave, dropping the oldest one if the queue is full
+void transport_push_received(const split_slave_matrix_push_t *push);
+// dequeues the oldest pushed frame, returns false if none is left
+bool transport_receive_push(split_slave_matrix_push_t *push);
+#endif // SPLIT_MATRIX_PUSH
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -199,4 +215,31 @@ typedef struct _split_shared_memory_t {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 } split_shared_memory_t;
 
+#ifdef SPLIT_TRANSPORT_COALESCE
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+#        define SPLIT_FRAME_DATA_SIZE offsetof(split_shared_memory_t, rpc_info)
+#    else
+#        define SPLIT_FRAME_DATA_SIZE sizeof(split_shared_memory_t)
+#    endif
+
+// The synced regions of one direction set in `mask`, back to back, exchanged as a single transaction per scan
+typedef struct __attribute__((packed)) _split_frame_t {
+    uint8_t  checksum;
+    uint8_t  flags;
+    uint32_t mask;
+    uint8_t  length;
+    uint8_t  data[SPLIT_FRAME_DATA_SIZE];
+} split_frame_t;
+
+#    define SPLIT_FRAME_HEADER_SIZE offsetof(split_frame_t, data)
+// Number of bytes of the frame that go over the wire
+#    define split_frame_size(frame) (SPLIT_FRAME_HEADER_SIZE + (frame)->length)
+
+typedef struct _split_coalesced_memory_t {
+    split_shared_memory_t shmem;
+    split_frame_t         m2s_frame;
+    split_frame_t         s2m_frame;
+} split_coalesced_memory_t;
+#endif // SPLIT_TRANSPORT_COALESCE
+
 extern split_shared_memory_t *const split_shmem;
@@ -0,0 +1,169 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "task_profile.h"
+#include "timer.h"
+#include "wait.h"
+#include "debug.h"
+#include "print.h"
+
+typedef struct {
+    uint16_t min;
+    uint16_t max;
+    uint32_t total;
+    uint16_t count;
+} task_profile_window_t;
+
+static uint32_t              slot_start[TASK_PROFILE_SLOT_COUNT];
+static task_profile_window_t current_window[TASK_PROFILE_SLOT_COUNT];
+static task_profile_stats_t  last_window[TASK_PROFILE_SLOT_COUNT];
+static uint32_t              window_timer    = 0;
+static uint32_t              scan_count      = 0;
+static uint32_t              last_scan_count = 0;
+
+// clang-format off
+static const char *const slot_names[TASK_PROFILE_SLOT_COUNT] = {
+    [TASK_PROFILE_SLOT_KEYBOARD_TASK]   = "keyboard_task",
+    [TASK_PROFILE_SLOT_MATRIX]          = "matrix",
+    [TASK_PROFILE_SLOT_QUANTUM]         = "quantum",
+    [TASK_PROFILE_SLOT_MUSIC]           = "music",
+    [TASK_PROFILE_SLOT_KEY_OVERRIDE]    = "key_override",
+    [TASK_PROFILE_SLOT_SEQUENCER]       = "sequencer",
+    [TASK_PROFILE_SLOT_TAP_DANCE]       = "tap_dance",
+    [TASK_PROFILE_SLOT_COMBO]           = "combo",
+    [TASK_PROFILE_SLOT_WPM]             = "wpm",
+    [TASK_PROFILE_SLOT_HAPTIC]          = "haptic",
+    [TASK_PROFILE_SLOT_DIP_SWITCH]      = "dip_switch",
+    [TASK_PROFILE_SLOT_AUTO_SHIFT]      = "auto_shift",
+    [TASK_PROFILE_SLOT_CAPS_WORD]       = "caps_word",
+    [TASK_PROFILE_SLOT_SECURE]          = "secure",
+    [TASK_PROFILE_SLOT_SPLIT_WATCHDOG]  = "split_watchdog",
+    [TASK_PROFILE_SLOT_RGBLIGHT]        = "rgblight",
+    [TASK_PROFILE_SLOT_LED_MATRIX]      = "led_matrix",
+    [TASK_PROFILE_SLOT_RGB_MATRIX]      = "rgb_matrix",
+    [TASK_PROFILE_SLOT_BACKLIGHT]       = "backlight",
+    [TASK_PROFILE_SLOT_ENCODER]         = "encoder",
+    [TASK_PROFILE_SLOT_OLED]            = "oled",
+    [TASK_PROFILE_SLOT_ST7565]          = "st7565",
+    [TASK_PROFILE_SLOT_MOUSEKEY]        = "mousekey",
+    [TASK_PROFILE_SLOT_PS2_MOUSE]       = "ps2_mouse",
+    [TASK_PROFILE_SLOT_POINTING_DEVICE] = "pointing_device",
+    [TASK_PROFILE_SLOT_MIDI]            = "midi",
+    [TASK_PROFILE_SLOT_VELOCIKEY]       = "velocikey",
+    [TASK_PROFILE_SLOT_JOYSTICK]        = "joystick",
+    [TASK_PROFILE_SLOT_BLUETOOTH]       = "bluetooth",
+    [TASK_PROFILE_SLOT_LED]             = "led",
+    [TASK_PROFILE_SLOT_QUANTUM_PAINTER] = "quantum_painter",
+    [TASK_PROFILE_SLOT_DEFERRED_EXEC]   = "deferred_exec",
+    [TASK_PROFILE_SLOT_HOUSEKEEPING]    = "housekeeping",
+    [TASK_PROFILE_SLOT_DYNAMIC_KEYMAP]  = "dynamic_keymap",
+    [TASK_PROFILE_SLOT_WEAR_LEVELING]   = "wear_leveling",
+    [TASK_PROFILE_SLOT_SEND_STRING]     = "send_string",
+    [TASK_PROFILE_SLOT_LEADER]          = "leader",
+};
+// clang-format on
+
+#if defined(PROTOCOL_CHIBIOS) && (PORT_SUPPORTS_RT == TRUE)
+#    define TASK_PROFILE_TIMER_READ() chSysGetRealtimeCounterX()
+#    define TASK_PROFILE_ELAPSED_US(start) ((uint32_t)(chSysGetRealtimeCounterX() - (start)) / (REALTIME_COUNTER_CLOCK / 1000000))
+#    define TASK_PROFILE_RESOLUTION_US 1
+#elif defined(PROTOCOL_CHIBIOS)
+// No cycle counter (e.g. ARMv6-M), fall back to the system tick, which is usually finer than a millisecond.
+#    define TASK_PROFILE_TIMER_READ() chVTGetSystemTimeX()
+#    define TASK_PROFILE_ELAPSED_US(start) TIME_I2US(chTimeDiffX((systime_t)(start), chVTGetSystemTimeX()))
+#    define TASK_PROFILE_RESOLUTION_US (1000000 / CH_CFG_ST_FREQUENCY)
+#else
+// Only the millisecond timer is available, the resolution is reported alongside the figures.
+#    define TASK_PROFILE_TIMER_READ() timer_read32()
+#    define TASK_PROFILE_ELAPSED_US(start) (timer_elapsed32(start) * 1000)
+#    define TASK_PROFILE_RESOLUTION_US 1000
+#endif
+
+void task_profile_begin(task_profile_slot_t slot) {
+    slot_start[slot] = TASK_PROFILE_TIMER_READ();
+}
+
+void task_profile_end(task_profile_slot_t slot) {
+    uint32_t elapsed = TASK_PROFILE_ELAPSED_US(slot_start[slot]);
+    if (elapsed > UINT16_MAX) {
+        elapsed = UINT16_MAX;
+    }
+
+    task_profile_window_t *window = &current_window[slot];
+    if (window->count == UINT16_MAX) {
+        return;
+    }
+    if (!window->count || elapsed < window->min) {
+        window->min = elapsed;
+    }
+    if (elapsed > window->max) {
+        window->max = elapsed;
+    }
+    window->total += elapsed;
+    window->count++;
+}
+
+static void task_profile_print(void) {
+#ifdef CONSOLE_ENABLE
+    if (!debug_enable) {
+        return;
+    }
+
+    dprintf("task profile: %lu scans/s, resolution %u us\n", (unsigned long)last_scan_count, (unsigned)TASK_PROFILE_RESOLUTION_US);
+    for (uint8_t slot = 0; slot < TASK_PROFILE_SLOT_COUNT; slot++) {
+        const task_profile_stats_t *stats = &last_window[slot];
+        if (stats->count) {
+            dprintf("  %-16s min %5u avg %5u max %5u us (%u calls)\n", slot_names[slot], stats->min, stats->avg, stats->max, stats->count);
+        }
+    }
+#endif
+}
+
+void task_profile_task(void) {
+    scan_count++;
+
+    uint32_t elapsed = timer_elapsed32(window_timer);
+    if (elapsed < TASK_PROFILE_WINDOW) {
+        return;
+    }
+
+    for (uint8_t slot = 0; slot < TASK_PROFILE_SLOT_COUNT; slot++) {
+        const task_profile_window_t *window = &current_window[slot];
+
+        last_window[slot].min   = window->min;
+        last_window[slot].avg   = window->count ? window->total / window->count : 0;
+        last_window[slot].max   = window->max;
+        last_window[slot].count = window->count;
+    }
+    last_scan_count = scan_count * 1000 / elapsed;
+    scan_count      = 0;
+
+    memset(current_window, 0, sizeof(current_window));
+    window_timer = timer_read32();
+
+    task_profile_print();
+}
+
+bool task_profile_get(task_profile_slot_t slot, task_profile_stats_t *stats) {
+    if (slot >= TASK_PROFILE_SLOT_COUNT || !last_window[slot].count) {
+        return false;
+    }
+
+    *stats = last_window[slot];
+    return true;
+}
+
+uint16_t task_profile_resolution_us(void) {
+    return TASK_PROFILE_RESOLUTION_US;
+}
+
+const char *task_profile_slot_name(task_profile_slot_t slot) {
+    return slot < TASK_PROFILE_SLOT_COUNT ? slot_names[slot] : NULL;
+}
+
+#ifndef DEBUG_MATRIX_SCAN_RATE
+uint32_t get_matrix_scan_rate(void) {
+    return last_scan_count;
+}
+#endif
@@ -0,0 +1,109 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Slots of the main loop which are timed by the task profiler.
+ *
+ * Each slot corresponds to one of the tasks called from the main loop. Slots
+ * of features which are not compiled in are simply never entered.
+ */
+typedef enum {
+    TASK_PROFILE_SLOT_KEYBOARD_TASK,
+    TASK_PROFILE_SLOT_MATRIX,
+    TASK_PROFILE_SLOT_QUANTUM,
+    TASK_PROFILE_SLOT_MUSIC,
+    TASK_PROFILE_SLOT_KEY_OVERRIDE,
+    TASK_PROFILE_SLOT_SEQUENCER,
+    TASK_PROFILE_SLOT_TAP_DANCE,
+    TASK_PROFILE_SLOT_COMBO,
+    TASK_PROFILE_SLOT_WPM,
+    TASK_PROFILE_SLOT_HAPTIC,
+    TASK_PROFILE_SLOT_DIP_SWITCH,
+    TASK_PROFILE_SLOT_AUTO_SHIFT,
+    TASK_PROFILE_SLOT_CAPS_WORD,
+    TASK_PROFILE_SLOT_SECURE,
+    TASK_PROFILE_SLOT_SPLIT_WATCHDOG,
+    TASK_PROFILE_SLOT_RGBLIGHT,
+    TASK_PROFILE_SLOT_LED_MATRIX,
+    TASK_PROFILE_SLOT_RGB_MATRIX,
+    TASK_PROFILE_SLOT_BACKLIGHT,
+    TASK_PROFILE_SLOT_ENCODER,
+    TASK_PROFILE_SLOT_OLED,
+    TASK_PROFILE_SLOT_ST7565,
+    TASK_PROFILE_SLOT_MOUSEKEY,
+    TASK_PROFILE_SLOT_PS2_MOUSE,
+    TASK_PROFILE_SLOT_POINTING_DEVICE,
+    TASK_PROFILE_SLOT_MIDI,
+    TASK_PROFILE_SLOT_VELOCIKEY,
+    TASK_PROFILE_SLOT_JOYSTICK,
+    TASK_PROFILE_SLOT_BLUETOOTH,
+    TASK_PROFILE_SLOT_LED,
+    TASK_PROFILE_SLOT_QUANTUM_PAINTER,
+    TASK_PROFILE_SLOT_DEFERRED_EXEC,
+    TASK_PROFILE_SLOT_HOUSEKEEPING,
+    TASK_PROFILE_SLOT_DYNAMIC_KEYMAP,
+    TASK_PROFILE_SLOT_WEAR_LEVELING,
+    TASK_PROFILE_SLOT_SEND_STRING,
+    TASK_PROFILE_SLOT_LEADER,
+    TASK_PROFILE_SLOT_COUNT,
+} task_profile_slot_t;
+
+/**
+ * @brief Execution time of a slot over the last completed window, in microseconds.
+ *
+ * The figures are multiples of task_profile_resolution_us().
+ */
+typedef struct {
+    uint16_t min;
+    uint16_t avg;
+    uint16_t max;
+    uint16_t count;
+} task_profile_stats_t;
+
+#ifdef DEBUG_TASK_PROFILE
+
+#    ifndef TASK_PROFILE_WINDOW
+#        define TASK_PROFILE_WINDOW 1000
+#    endif
+
+void task_profile_begin(task_profile_slot_t slot);
+void task_profile_end(task_profile_slot_t slot);
+
+/**
+ * @brief Closes the current window once TASK_PROFILE_WINDOW has elapsed.
+ *
+ * Called once per main loop iteration.
+ */
+void task_profile_task(void);
+
+/**
+ * @brief Retrieves the statistics of `slot` for the last completed window.
+ *
+ * @return false if `slot` is out of range or was not entered during that window
+ */
+bool task_profile_get(task_profile_slot_t slot, task_profile_stats_t *stats);
+
+/**
+ * @brief Resolution of the timer backing the profiler, in microseconds.
+ *
+ * 1 with a cycle counter, the system tick period on other ChibiOS targets, and
+ * 1000 where only the millisecond timer is available.
+ */
+uint16_t task_profile_resolution_us(void);
+
+const char *task_profile_slot_name(task_profile_slot_t slot);
+
+#    define TASK_PROFILE_BEGIN(slot) task_profile_begin(TASK_PROFILE_SLOT_##slot)
+#    define TASK_PROFILE_END(slot) task_profile_end(TASK_PROFILE_SLOT_##slot)
+
+#else
+
+#    define TASK_PROFILE_BEGIN(slot)
+#    define TASK_PROFILE_END(slot)
+
+#endif
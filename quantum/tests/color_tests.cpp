@@ -0,0 +1,129 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+#include "led_tables.h"
+#include "progmem.h"
+}
+
+// Field order of RGB depends on WS2812_BYTE_ORDER, so it can't be brace-initialised
+static RGB make_rgb(uint8_t r, uint8_t g, uint8_t b) {
+    RGB rgb;
+    rgb.r = r;
+    rgb.g = g;
+    rgb.b = b;
+    return rgb;
+}
+
+/**
+ * Per-pixel conversion as originally implemented, which the optimised conversion has to match exactly.
+ */
+static RGB reference_hsv_to_rgb(HSV hsv) {
+    uint8_t region, remainder, p, q, t;
+    uint8_t h = hsv.h, s = hsv.s, v = hsv.v;
+
+#ifdef USE_CIE1931_CURVE
+    v = pgm_read_byte(&CIE1931_CURVE[hsv.v]);
+#endif
+
+    if (s == 0) {
+        return make_rgb(v, v, v);
+    }
+
+    region    = h * 6 / 255;
+    remainder = (h * 2 - region * 85) * 3;
+
+    p = (v * (255 - s)) >> 8;
+    q = (v * (255 - ((s * remainder) >> 8))) >> 8;
+    t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+    RGB rgb;
+    switch (region) {
+        case 6:
+        case 0:
+            rgb = make_rgb(v, t, p);
+            break;
+        case 1:
+            rgb = make_rgb(q, v, p);
+            break;
+        case 2:
+            rgb = make_rgb(p, v, t);
+            break;
+        case 3:
+            rgb = make_rgb(p, q, v);
+            break;
+        case 4:
+            rgb = make_rgb(t, p, v);
+            break;
+        default:
+            rgb = make_rgb(v, p, q);
+            break;
+    }
+    return rgb;
+}
+
+static bool operator==(const RGB& a, const RGB& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+class Color : public ::testing::Test {
+   protected:
+    // Size of the simulated frame
+    static constexpr size_t frame_size = 128;
+
+    static std::vector<HSV> make_frame(void) {
+        std::vector<HSV> frame(frame_size);
+        for (size_t i = 0; i < frame_size; ++i) {
+            frame[i] = {(uint8_t)(i * 7), (uint8_t)(255 - i), (uint8_t)(128 + i)};
+        }
+        return frame;
+    }
+};
+
+/**
+ * This test verifies that every possible HSV value converts to the same RGB value as the original implementation, both
+ * one at a time and in batches.
+ */
+TEST_F(Color, MatchesReferenceExhaustively) {
+    HSV hsv[256];
+    RGB rgb[256];
+
+    for (unsigned h = 0; h < 256; ++h) {
+        for (unsigned s = 0; s < 256; ++s) {
+            for (unsigned v = 0; v < 256; ++v) {
+                hsv[v] = {(uint8_t)h, (uint8_t)s, v};
+            }
+            hsv_to_rgb_batch(hsv, rgb, 255);
+            hsv_to_rgb_batch(&hsv[255], &rgb[255], 1);
+
+            for (unsigned v = 0; v < 256; ++v) {
+                RGB expected = reference_hsv_to_rgb(hsv[v]);
+                ASSERT_TRUE(hsv_to_rgb(hsv[v]) == expected) << "Single conversion mismatch for " << h << "," << s << "," << v;
+                ASSERT_TRUE(rgb[v] == expected) << "Batch conversion mismatch for " << h << "," << s << "," << v;
+            }
+        }
+    }
+}
+
+/**
+ * This test verifies that converting a frame worth of LEDs in one batch gives the same colors as converting each LED on
+ * its own, as the effect runners do unless RGB_MATRIX_HSV_BATCH is defined.
+ */
+TEST_F(Color, BatchMatchesPerLedConversion) {
+    auto             frame = make_frame();
+    std::vector<RGB> rgb(frame_size);
+
+    for (unsigned run = 0; run < 256; ++run) {
+        for (auto& hsv : frame) {
+            hsv.h++;
+        }
+        hsv_to_rgb_batch(frame.data(), rgb.data(), frame_size);
+
+        for (size_t i = 0; i < frame_size; ++i) {
+            ASSERT_TRUE(rgb[i] == hsv_to_rgb(frame[i])) << "Batch conversion mismatch for LED " << i << " of run " << run;
+        }
+    }
+}
@@ -0,0 +1,24 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 2
+#define MATRIX_COLS 2
+#define MATRIX_ROW_PINS \
+    { 0, 1 }
+#define MATRIX_COL_PINS \
+    { 2, 3 }
+#define DIODE_DIRECTION COL2ROW
+#define MATRIX_IDLE_WAKE
+#define MATRIX_IDLE_WAKE_TIMEOUT 20
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "matrix_mock.h"
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,80 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "matrix.h"
+#include "timer.h"
+#include "tests/matrix_mock.h"
+
+void advance_time(uint32_t ms);
+
+static bool interrupts_available;
+static bool press_while_arming;
+
+/* Pin interrupts which only ever fire when the test signals an edge */
+bool matrix_idle_wake_arm_pin(pin_t pin) {
+    if (press_while_arming) {
+        mock_matrix_set_key(1, 0, true);
+    }
+    return interrupts_available;
+}
+
+void matrix_idle_wake_disarm_pin(pin_t pin) {}
+}
+
+class MatrixIdleWake : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        interrupts_available = true;
+        press_while_arming   = false;
+        timer_init();
+        mock_matrix_reset();
+        matrix_init();
+    }
+
+    void scan_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            matrix_scan();
+            advance_time(1);
+        }
+    }
+};
+
+TEST_F(MatrixIdleWake, StopsScanningWhenIdle) {
+    scan_for(MATRIX_IDLE_WAKE_TIMEOUT + 5);
+
+    uint32_t reads = mock_matrix_input_reads();
+    scan_for(100);
+    EXPECT_EQ(mock_matrix_input_reads(), reads);
+}
+
+TEST_F(MatrixIdleWake, WakesOnEdge) {
+    scan_for(MATRIX_IDLE_WAKE_TIMEOUT + 5);
+
+    mock_matrix_set_key(0, 1, true);
+    scan_for(10);
+    EXPECT_EQ(matrix_get_row(0), 0);
+
+    matrix_idle_wake_signal();
+    matrix_scan();
+    EXPECT_EQ(matrix_get_row(0), 0b10);
+}
+
+TEST_F(MatrixIdleWake, WakesForKeyHeldAcrossIdleEntry) {
+    // The key goes down after the last scan, but before the interrupts are armed, so no edge is ever seen
+    press_while_arming = true;
+    scan_for(MATRIX_IDLE_WAKE_TIMEOUT + 5);
+
+    EXPECT_EQ(matrix_get_row(1), 0b01);
+}
+
+TEST_F(MatrixIdleWake, PollsWithoutInterrupts) {
+    interrupts_available = false;
+    scan_for(MATRIX_IDLE_WAKE_TIMEOUT + 5);
+
+    mock_matrix_set_key(1, 1, true);
+    matrix_scan();
+    EXPECT_EQ(matrix_get_row(1), 0b10);
+}
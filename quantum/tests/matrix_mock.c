@@ -0,0 +1,61 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "matrix_mock.h"
+#include "matrix.h"
+
+static const pin_t mock_row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t mock_col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+static bool     pin_is_output[32];
+static bool     pin_level[32];
+static bool     keys[MATRIX_ROWS][MATRIX_COLS];
+static uint32_t input_reads;
+
+void mock_set_pin_input_high(pin_t pin) {
+    pin_is_output[pin] = false;
+    pin_level[pin]     = true;
+}
+
+void mock_set_pin_output(pin_t pin) {
+    pin_is_output[pin] = true;
+}
+
+void mock_write_pin(pin_t pin, bool high) {
+    pin_level[pin] = high;
+}
+
+bool mock_read_pin(pin_t pin) {
+    input_reads++;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        if (mock_col_pins[col] != pin) {
+            continue;
+        }
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            if (keys[row][col] && pin_is_output[mock_row_pins[row]] && !pin_level[mock_row_pins[row]]) {
+                return false;
+            }
+        }
+    }
+    return pin_level[pin];
+}
+
+void mock_matrix_reset(void) {
+    memset(pin_is_output, 0, sizeof(pin_is_output));
+    memset(pin_level, 0, sizeof(pin_level));
+    memset(keys, 0, sizeof(keys));
+    input_reads = 0;
+}
+
+void mock_matrix_set_key(uint8_t row, uint8_t col, bool pressed) {
+    keys[row][col] = pressed;
+}
+
+uint32_t mock_matrix_input_reads(void) {
+    return input_reads;
+}
+
+void matrix_init_quantum(void) {}
+
+void matrix_scan_quantum(void) {}
@@ -0,0 +1,26 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t pin_t;
+
+#define setPinInputHigh(pin) mock_set_pin_input_high(pin)
+#define setPinOutput(pin) mock_set_pin_output(pin)
+#define writePinLow(pin) mock_write_pin(pin, false)
+#define writePinHigh(pin) mock_write_pin(pin, true)
+#define readPin(pin) mock_read_pin(pin)
+
+void mock_set_pin_input_high(pin_t pin);
+void mock_set_pin_output(pin_t pin);
+void mock_write_pin(pin_t pin, bool high);
+bool mock_read_pin(pin_t pin);
+
+/* Electrical model of a COL2ROW diode matrix: an input reads low while a
+ * pressed key connects it to an output driven low. */
+void     mock_matrix_reset(void);
+void     mock_matrix_set_key(uint8_t row, uint8_t col, bool pressed);
+uint32_t mock_matrix_input_reads(void);
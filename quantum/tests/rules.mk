@@ -0,0 +1,26 @@
+color_DEFS := -DNO_DEBUG
+color_SRC := \
+	$(QUANTUM_PATH)/tests/color_tests.cpp \
+	$(QUANTUM_PATH)/color.c
+
+color_cie1931_DEFS := -DNO_DEBUG -DUSE_CIE1931_CURVE
+color_cie1931_SRC := \
+	$(color_SRC) \
+	$(QUANTUM_PATH)/led_tables.c
+
+matrix_idle_wake_DEFS := -DNO_DEBUG -DIGNORE_ATOMIC_BLOCK
+matrix_idle_wake_CONFIG := $(QUANTUM_PATH)/tests/config_matrix_idle_wake.h
+matrix_idle_wake_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/tests/matrix_mock.c \
+	$(QUANTUM_PATH)/tests/matrix_idle_wake_tests.cpp \
+	$(QUANTUM_PATH)/bitwise.c \
+	$(QUANTUM_PATH)/matrix_common.c \
+	$(QUANTUM_PATH)/matrix.c \
+	$(QUANTUM_PATH)/debounce/none.c
+
+task_profile_DEFS := -DNO_DEBUG -DDEBUG_TASK_PROFILE
+task_profile_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/tests/task_profile_tests.cpp \
+	$(QUANTUM_PATH)/task_profile.c
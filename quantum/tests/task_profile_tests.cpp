@@ -0,0 +1,96 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "task_profile.h"
+#include "timer.h"
+
+uint32_t get_matrix_scan_rate(void);
+void     advance_time(uint32_t ms);
+}
+
+class TaskProfile : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        // Start from an empty window, whatever the previous test left behind
+        close_window();
+    }
+
+    void close_window() {
+        advance_time(TASK_PROFILE_WINDOW);
+        task_profile_task();
+    }
+
+    void run_slot(task_profile_slot_t slot, uint32_t ms) {
+        task_profile_begin(slot);
+        advance_time(ms);
+        task_profile_end(slot);
+    }
+};
+
+TEST_F(TaskProfile, ReportsTheMillisecondTimerResolution) {
+    EXPECT_EQ(task_profile_resolution_us(), 1000);
+}
+
+TEST_F(TaskProfile, ReportsMinAvgMaxOfTheLastWindow) {
+    run_slot(TASK_PROFILE_SLOT_MATRIX, 1);
+    run_slot(TASK_PROFILE_SLOT_MATRIX, 2);
+    run_slot(TASK_PROFILE_SLOT_MATRIX, 6);
+
+    task_profile_stats_t stats;
+    EXPECT_FALSE(task_profile_get(TASK_PROFILE_SLOT_MATRIX, &stats));
+
+    close_window();
+    ASSERT_TRUE(task_profile_get(TASK_PROFILE_SLOT_MATRIX, &stats));
+    EXPECT_EQ(stats.min, 1000);
+    EXPECT_EQ(stats.avg, 3000);
+    EXPECT_EQ(stats.max, 6000);
+    EXPECT_EQ(stats.count, 3);
+
+    // The next window starts from scratch
+    close_window();
+    EXPECT_FALSE(task_profile_get(TASK_PROFILE_SLOT_MATRIX, &stats));
+}
+
+TEST_F(TaskProfile, SlotsAreTimedIndependently) {
+    task_profile_begin(TASK_PROFILE_SLOT_KEYBOARD_TASK);
+    run_slot(TASK_PROFILE_SLOT_MATRIX, 2);
+    run_slot(TASK_PROFILE_SLOT_QUANTUM, 3);
+    task_profile_end(TASK_PROFILE_SLOT_KEYBOARD_TASK);
+    close_window();
+
+    task_profile_stats_t stats;
+    ASSERT_TRUE(task_profile_get(TASK_PROFILE_SLOT_KEYBOARD_TASK, &stats));
+    EXPECT_EQ(stats.max, 5000);
+    ASSERT_TRUE(task_profile_get(TASK_PROFILE_SLOT_MATRIX, &stats));
+    EXPECT_EQ(stats.max, 2000);
+    ASSERT_TRUE(task_profile_get(TASK_PROFILE_SLOT_QUANTUM, &stats));
+    EXPECT_EQ(stats.max, 3000);
+    EXPECT_FALSE(task_profile_get(TASK_PROFILE_SLOT_OLED, &stats));
+}
+
+TEST_F(TaskProfile, LongTasksSaturate) {
+    run_slot(TASK_PROFILE_SLOT_OLED, 100);
+    close_window();
+
+    task_profile_stats_t stats;
+    ASSERT_TRUE(task_profile_get(TASK_PROFILE_SLOT_OLED, &stats));
+    EXPECT_EQ(stats.max, UINT16_MAX);
+}
+
+TEST_F(TaskProfile, MeasuresTheScanRate) {
+    for (uint16_t i = 0; i < 100; i++) {
+        advance_time(TASK_PROFILE_WINDOW / 100);
+        task_profile_task();
+    }
+    EXPECT_EQ(get_matrix_scan_rate(), 100);
+}
+
+TEST_F(TaskProfile, RejectsSlotsOutOfRange) {
+    task_profile_stats_t stats;
+    EXPECT_FALSE(task_profile_get(TASK_PROFILE_SLOT_COUNT, &stats));
+    EXPECT_EQ(task_profile_slot_name(TASK_PROFILE_SLOT_COUNT), nullptr);
+    EXPECT_STREQ(task_profile_slot_name(TASK_PROFILE_SLOT_RGB_MATRIX), "rgb_matrix");
+}
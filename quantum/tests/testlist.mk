@@ -0,0 +1 @@
+TEST_LIST += color color_cie1931 matrix_idle_wake task_profile
@@ -25,6 +25,7 @@
 #include "wait.h"
 #include "send_string.h"
 #include "utf8.h"
+#include "keycode_config.h"
 
 #if defined(AUDIO_ENABLE)
 #    include "audio.h"
@@ -304,26 +305,94 @@ __attribute__((weak)) void unicode_input_cancel(void) {
     set_mods(unicode_saved_mods); // Reregister previously set mods
 }
 
+// Hex digits currently held down by send_nibble_wrapper(), one bit per digit value
+static uint16_t held_digits;
+
 // clang-format off
 
-static void send_nibble_wrapper(uint8_t digit) {
+/**
+ * \brief Gets the keycode to send for a hex digit in the current input mode.
+ *
+ * \return KC_NO if the digit needs modifiers in the current send_string layout
+ */
+static uint8_t digit_keycode(uint8_t digit) {
     if (unicode_config.input_mode == UNICODE_MODE_WINDOWS) {
-        uint8_t kc = digit < 10
-                   ? KC_KP_1 + (10 + digit - 1) % 10
-                   : KC_A + (digit - 10);
-        tap_code(kc);
-        return;
+        return digit < 10
+             ? KC_KP_1 + (10 + digit - 1) % 10
+             : KC_A + (digit - 10);
+    }
+
+    uint8_t ascii_code = digit < 10 ? '0' + digit : 'a' + (digit - 10);
+    if (PGM_LOADBIT(ascii_to_shift_lut, ascii_code) || PGM_LOADBIT(ascii_to_altgr_lut, ascii_code) || PGM_LOADBIT(ascii_to_dead_lut, ascii_code)) {
+        return KC_NO;
     }
-    send_nibble(digit);
+    return pgm_read_byte(&ascii_to_keycode_lut[ascii_code]);
 }
 
 // clang-format on
 
+static bool digit_slot_available(void) {
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        return true;
+    }
+#endif
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        if (!keyboard_report->keys[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** \brief Releases all hex digits held down by send_nibble_wrapper() in a single report.
+ */
+static void release_digits(void) {
+    if (!held_digits) {
+        return;
+    }
+    for (uint8_t digit = 0; digit < 16; digit++) {
+        if (held_digits & (1 << digit)) {
+            del_key(digit_keycode(digit));
+        }
+    }
+    held_digits = 0;
+    send_keyboard_report();
+}
+
+/** \brief Types a hex digit.
+ *
+ * Rather than tapping each digit, digits are pressed one per report and kept
+ * held, so that every report still adds exactly one key and the host sees them
+ * in order. They're only released once a digit repeats, the report is full, or
+ * release_digits() is called at the end of the sequence. This takes one report
+ * per digit instead of two.
+ */
+static void send_nibble_wrapper(uint8_t digit) {
+    uint8_t keycode = digit_keycode(digit);
+    if (keycode == KC_NO) {
+        release_digits();
+        send_nibble(digit);
+        return;
+    }
+
+    if ((held_digits & (1 << digit)) || !digit_slot_available()) {
+        release_digits();
+    }
+    add_key(keycode);
+    held_digits |= 1 << digit;
+    send_keyboard_report();
+#if TAP_CODE_DELAY > 0
+    wait_ms(TAP_CODE_DELAY);
+#endif
+}
+
 void register_hex(uint16_t hex) {
     for (int i = 3; i >= 0; i--) {
         uint8_t digit = ((hex >> (i * 4)) & 0xF);
         send_nibble_wrapper(digit);
     }
+    release_digits();
 }
 
 void register_hex32(uint32_t hex) {
@@ -349,15 +418,14 @@ void register_hex32(uint32_t hex) {
             first_digit = false;
         }
     }
+    release_digits();
 }
 
-void register_unicode(uint32_t code_point) {
-    if (code_point > 0x10FFFF || (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_WINDOWS)) {
-        // Code point out of range, do nothing
-        return;
-    }
+static bool unicode_code_point_valid(uint32_t code_point) {
+    return code_point <= 0x10FFFF && !(code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_WINDOWS);
+}
 
-    unicode_input_start();
+static void register_code_point_hex(uint32_t code_point) {
     if (code_point > 0xFFFF && unicode_config.input_mode == UNICODE_MODE_MACOS) {
         // Convert code point to UTF-16 surrogate pair on macOS
         code_point -= 0x10000;
@@ -367,6 +435,16 @@ void register_unicode(uint32_t code_point) {
     } else {
         register_hex32(code_point);
     }
+}
+
+void register_unicode(uint32_t code_point) {
+    if (!unicode_code_point_valid(code_point)) {
+        // Code point out of range, do nothing
+        return;
+    }
+
+    unicode_input_start();
+    register_code_point_hex(code_point);
     unicode_input_finish();
 }
 
@@ -375,12 +453,30 @@ void send_unicode_string(const char *str) {
         return;
     }
 
+    // Unicode Hex Input on macOS keeps accepting code points for as long as the
+    // modifier is held, so a single input session covers the whole string. The
+    // other input modes commit on finish, and need a session per code point.
+    bool session_open = false;
+
     while (*str) {
         int32_t code_point = 0;
         str                = decode_utf8(str, &code_point);
 
-        if (code_point >= 0) {
+        if (code_point < 0 || !unicode_code_point_valid(code_point)) {
+            continue;
+        }
+        if (unicode_config.input_mode != UNICODE_MODE_MACOS) {
             register_unicode(code_point);
+            continue;
         }
+        if (!session_open) {
+            unicode_input_start();
+            session_open = true;
+        }
+        register_code_point_hex(code_point);
+    }
+
+    if (session_open) {
+        unicode_input_finish();
     }
 }
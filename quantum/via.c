@@ -31,6 +31,10 @@
 #include "eeprom.h"
 #include "version.h" // for QMK_BUILDDATE used in EEPROM magic
 
+#if defined(DEBUG_TASK_PROFILE)
+#    include "task_profile.h"
+#endif
+
 #if defined(RGB_MATRIX_ENABLE)
 #    include <lib/lib8tion/lib8tion.h>
 #endif
@@ -332,6 +336,36 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
                     command_data[4] = value & 0xFF;
                     break;
                 }
+#if defined(DEBUG_TASK_PROFILE)
+                case id_task_profile: {
+                    // command_data[1] selects the slot, slots past the last one are unhandled.
+                    // Returns min, avg and max execution time in microseconds and the number of calls
+                    // during the last window, followed by the scan rate and the timer resolution in microseconds.
+                    if (command_data[1] >= TASK_PROFILE_SLOT_COUNT) {
+                        *command_id = id_unhandled;
+                        break;
+                    }
+                    task_profile_stats_t stats = {0};
+                    task_profile_get(command_data[1], &stats);
+                    uint32_t scan_rate  = get_matrix_scan_rate();
+                    uint16_t resolution = task_profile_resolution_us();
+                    command_data[2]     = stats.min >> 8;
+                    command_data[3]     = stats.min & 0xFF;
+                    command_data[4]     = stats.avg >> 8;
+                    command_data[5]     = stats.avg & 0xFF;
+                    command_data[6]     = stats.max >> 8;
+                    command_data[7]     = stats.max & 0xFF;
+                    command_data[8]     = stats.count >> 8;
+                    command_data[9]     = stats.count & 0xFF;
+                    command_data[10]    = (scan_rate >> 24) & 0xFF;
+                    command_data[11]    = (scan_rate >> 16) & 0xFF;
+                    command_data[12]    = (scan_rate >> 8) & 0xFF;
+                    command_data[13]    = scan_rate & 0xFF;
+                    command_data[14]    = resolution >> 8;
+                    command_data[15]    = resolution & 0xFF;
+                    break;
+                }
+#endif
                 default: {
                     // The value ID is not known
                     // Return the unhandled state
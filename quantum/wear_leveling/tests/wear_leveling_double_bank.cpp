@@ -0,0 +1,225 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingDoubleBank : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+static logical_data_t read_logical(void) {
+    logical_data_t data;
+    wear_leveling_read(0, data.data(), data.size());
+    return data;
+}
+
+/**
+ * Runs background consolidation until the switch to the other bank occurs, returning the number of steps taken.
+ */
+static int run_consolidation(void) {
+    for (int steps = 1; steps < 1000; ++steps) {
+        wear_leveling_status_t status = wear_leveling_task();
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Consolidation step failed";
+        if (status != WEAR_LEVELING_SUCCESS) {
+            return steps;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Fills the write log up to the consolidation threshold using single-byte writes.
+ */
+static void fill_to_threshold(logical_data_t& expected) {
+    for (uint32_t i = 0; i < (WEAR_LEVELING_CONSOLIDATE_THRESHOLD) / (BACKING_STORE_WRITE_SIZE); ++i) {
+        uint8_t value = 0x40 + i;
+        expected[i]   = value;
+        EXPECT_EQ(wear_leveling_write(i, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+}
+
+/**
+ * This test verifies that the first write after initialisation occurs after the FNV1a_64 hash and sequence number.
+ */
+TEST_F(WearLevelingDoubleBank, FirstWriteOccursAfterHeader) {
+    auto&   inst       = MockBackingStore::Instance();
+    uint8_t test_value = 0x15;
+    wear_leveling_write(0x02, &test_value, sizeof(test_value));
+    EXPECT_EQ(inst.log_begin()->address, WEAR_LEVELING_LOGICAL_SIZE + 16) << "Invalid first write address.";
+}
+
+/**
+ * This test verifies that background consolidation does nothing until the write log reaches the threshold.
+ */
+TEST_F(WearLevelingDoubleBank, TaskIdleBelowThreshold) {
+    auto&   inst       = MockBackingStore::Instance();
+    uint8_t test_value = 0x15;
+    wear_leveling_write(0x02, &test_value, sizeof(test_value));
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Erase occurred below the threshold";
+    EXPECT_EQ(inst.write_invoke_count(), 1) << "Unexpected writes below the threshold";
+}
+
+/**
+ * This test verifies that background consolidation is split into bounded steps, never erases the active bank, and that
+ * subsequent writes go to the write log of the newly active bank.
+ */
+TEST_F(WearLevelingDoubleBank, BackgroundConsolidation) {
+    auto&          inst     = MockBackingStore::Instance();
+    logical_data_t expected = {};
+    fill_to_threshold(expected);
+
+    const int erase_steps = (WEAR_LEVELING_BANK_SIZE) / (BACKING_STORE_ERASE_SIZE);
+    const int copy_steps  = (WEAR_LEVELING_LOGICAL_SIZE) / (WEAR_LEVELING_CONSOLIDATE_STEP_SIZE);
+    EXPECT_EQ(run_consolidation(), erase_steps + copy_steps + 1) << "Unexpected number of consolidation steps";
+    EXPECT_EQ(inst.erase_invoke_count(), erase_steps) << "Unexpected number of erases";
+
+    // The previously active bank must not have been erased
+    for (auto it = inst.storage_begin(); it != inst.storage_begin() + (WEAR_LEVELING_BANK_SIZE) / (BACKING_STORE_WRITE_SIZE); ++it) {
+        EXPECT_EQ(it->num_erases(), 0) << "Active bank was erased";
+    }
+
+    // Next write occurs in the second bank's write log
+    uint8_t test_value = 0x15;
+    expected[0x03]     = test_value;
+    EXPECT_EQ(wear_leveling_write(0x03, &test_value, sizeof(test_value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ((inst.log_end() - 1)->address, WEAR_LEVELING_BANK_SIZE + WEAR_LEVELING_LOGICAL_SIZE + 16) << "Invalid write address after consolidation.";
+
+    // Re-init and verify
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_logical(), expected) << "Logical data mismatch after consolidation";
+}
+
+/**
+ * This test verifies that writes made while consolidation is in progress are retained after switching banks.
+ */
+TEST_F(WearLevelingDoubleBank, WritesDuringConsolidation) {
+    logical_data_t expected = {};
+    fill_to_threshold(expected);
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint8_t i = 0; status == WEAR_LEVELING_SUCCESS; ++i) {
+        // Overwrite data both before and after the part which has already been copied
+        uint32_t address  = (i * 5) % (WEAR_LEVELING_LOGICAL_SIZE);
+        uint8_t  value    = 0x80 + i;
+        expected[address] = value;
+        EXPECT_NE(wear_leveling_write(address, &value, sizeof(value)), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+
+        status = wear_leveling_task();
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Task returned incorrect status";
+    }
+
+    EXPECT_EQ(read_logical(), expected) << "Logical data mismatch after consolidation";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    EXPECT_EQ(read_logical(), expected) << "Logical data mismatch after re-init";
+}
+
+/**
+ * This test verifies that if the write log fills up without the task being invoked, consolidation into the other bank
+ * occurs in-line, and that the banks alternate.
+ */
+TEST_F(WearLevelingDoubleBank, ConsolidationOverflow) {
+    auto&          inst     = MockBackingStore::Instance();
+    logical_data_t expected = {};
+
+    for (int bank = 0; bank < 3; ++bank) {
+        wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+        for (uint8_t i = 0; status == WEAR_LEVELING_SUCCESS; ++i) {
+            uint32_t address  = i % (WEAR_LEVELING_LOGICAL_SIZE);
+            uint8_t  value    = 0x20 + bank * 0x40 + i;
+            expected[address] = value;
+            status             = wear_leveling_write(address, &value, sizeof(value));
+        }
+        EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Write returned incorrect status";
+
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(read_logical(), expected) << "Logical data mismatch after consolidation";
+    }
+
+    // Three consolidations have occurred, the last one into the second bank
+    EXPECT_EQ(inst.erasure_count(), 3 * (WEAR_LEVELING_BANK_SIZE) / (BACKING_STORE_ERASE_SIZE)) << "Unexpected number of erases";
+    uint8_t test_value = 0x15;
+    wear_leveling_write(0x03, &test_value, sizeof(test_value));
+    EXPECT_GE((inst.log_end() - 1)->address, WEAR_LEVELING_BANK_SIZE) << "Invalid write address after consolidation.";
+}
+
+/**
+ * This test simulates a power loss after every single backing store operation during a mix of writes and background
+ * consolidation, verifying that only the write in progress at the time may be lost.
+ */
+TEST_F(WearLevelingDoubleBank, PowerLossAtEveryStep) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (std::size_t fail_after = 0;; ++fail_after) {
+        inst.reset_instance();
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+
+        // Start off with some data already consolidated, and a partially-filled write log
+        logical_data_t committed = {};
+        std::iota(committed.begin(), committed.end(), 0x01);
+        EXPECT_NE(wear_leveling_write(0, committed.data(), committed.size()), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+
+        // Fail every backing store operation after the first `fail_after`
+        std::size_t ops       = 0;
+        auto        power_ok  = [&ops, fail_after]() { return ops++ < fail_after; };
+        bool        lost      = false;
+        auto        in_flight = committed;
+        inst.set_write_callback([&](std::uint64_t, std::uint32_t) { return power_ok(); });
+        inst.set_erase_callback([&](std::uint64_t) { return power_ok(); });
+
+        for (uint8_t i = 0; i < 40 && !lost; ++i) {
+            if (wear_leveling_task() == WEAR_LEVELING_FAILED) {
+                lost = true;
+                break;
+            }
+
+            // Writes are unique so that none are skipped, with bursts every so often to overflow the write log
+            for (int burst = 0; burst < ((i % 8) == 7 ? 16 : 1); ++burst) {
+                uint32_t address   = (i * 7 + burst) % (WEAR_LEVELING_LOGICAL_SIZE);
+                uint8_t  value     = 0x80 + i + burst * 0x40;
+                in_flight          = committed;
+                in_flight[address] = value;
+                if (wear_leveling_write(address, &value, sizeof(value)) == WEAR_LEVELING_FAILED) {
+                    lost = true;
+                    break;
+                }
+                committed = in_flight;
+            }
+        }
+
+        // "Power on" again
+        inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+        inst.set_erase_callback([](std::uint64_t) { return true; });
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Init returned incorrect status";
+
+        auto data = read_logical();
+        EXPECT_TRUE(data == committed || data == in_flight) << "Logical data mismatch after power loss at step " << fail_after;
+
+        // Consolidation needs to recover from whatever was left in the inactive bank
+        bool switched = false;
+        for (uint32_t i = 0; i < 1000 && !switched; ++i) {
+            uint8_t value                         = 0x5A ^ i;
+            data[i % (WEAR_LEVELING_LOGICAL_SIZE)] = value;
+            switched |= wear_leveling_write(i % (WEAR_LEVELING_LOGICAL_SIZE), &value, sizeof(value)) == WEAR_LEVELING_CONSOLIDATED;
+            switched |= wear_leveling_task() == WEAR_LEVELING_CONSOLIDATED;
+        }
+        EXPECT_TRUE(switched) << "Consolidation did not complete";
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(read_logical(), data) << "Logical data mismatch after recovery from power loss at step " << fail_after;
+
+        if (!lost) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,82 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingStartup : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    /**
+     * Runs wear_leveling_init(), checking that it leaves the backing store untouched and returning the number of read
+     * transactions it issued.
+     */
+    std::uint64_t count_init_reads() {
+        auto&         inst   = MockBackingStore::Instance();
+        std::uint64_t reads  = inst.read_invoke_count() + inst.read_bulk_invoke_count();
+        std::uint64_t writes = inst.write_invoke_count();
+        std::uint64_t erases = inst.erase_invoke_count();
+
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        EXPECT_EQ(inst.write_invoke_count(), writes) << "Init should not write to the backing store";
+        EXPECT_EQ(inst.erase_invoke_count(), erases) << "Init should not erase the backing store";
+        return inst.read_invoke_count() + inst.read_bulk_invoke_count() - reads;
+    }
+};
+
+/**
+ * This test checks startup with an empty write log, which should only need to read the consolidated area and the
+ * first chunk of the log.
+ */
+TEST_F(WearLevelingStartup, EmptyLog) {
+    EXPECT_LE(count_init_reads(), 3) << "Too many read transactions during init";
+}
+
+/**
+ * This test checks startup with a write log filled right up to the point of consolidation, verifying that the log is
+ * replayed in bulk and that the replayed data is correct.
+ */
+TEST_F(WearLevelingStartup, FullLog) {
+    auto&                                                inst     = MockBackingStore::Instance();
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected = {};
+
+    // Mix of single-byte, word, and multi-byte writes, stopping short of filling the log
+    const std::size_t log_capacity = (WEAR_LEVELING_BACKING_SIZE) - (WEAR_LEVELING_LOG_OFFSET);
+    for (std::uint32_t i = 0; (inst.write_invoke_count() + 4) * (BACKING_STORE_WRITE_SIZE) < log_capacity; ++i) {
+        std::uint8_t  value[5];
+        std::uint32_t address;
+        std::size_t   length;
+        switch (i % 3) {
+            case 0:
+                address  = i % 64;
+                length   = 1;
+                value[0] = i;
+                break;
+            case 1:
+                address  = (i * 2) % 1024;
+                length   = 2;
+                value[0] = i & 1;
+                value[1] = 0;
+                break;
+            default:
+                address = 64 + (i * 7) % ((WEAR_LEVELING_LOGICAL_SIZE) - 64 - 5);
+                length  = 5;
+                std::iota(value, value + 5, i);
+                break;
+        }
+        memcpy(&expected[address], value, length);
+        EXPECT_NE(wear_leveling_write(address, value, length), WEAR_LEVELING_CONSOLIDATED) << "Write log filled up unexpectedly";
+    }
+
+    const std::size_t log_bytes = inst.write_invoke_count() * (BACKING_STORE_WRITE_SIZE);
+    EXPECT_LE(count_init_reads(), log_bytes / ((WEAR_LEVELING_PLAYBACK_BULK_COUNT) * (BACKING_STORE_WRITE_SIZE)) + 3) << "Too many read transactions during init";
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+    wear_leveling_read(0, actual.data(), actual.size());
+    EXPECT_EQ(actual, expected) << "Logical data mismatch after replay";
+}
@@ -66,7 +66,9 @@
         During initialization:
             * The contents of the consolidated data section are read into cache.
             * The contents of the write log are "played back" and update the
-                cache accordingly.
+                cache accordingly. The log is read in chunks of
+                WEAR_LEVELING_PLAYBACK_BULK_COUNT backing store writes at a
+                time, stopping at the first empty slot.
 
         During reads:
             * Logical data is served from the cache.
@@ -153,7 +155,26 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Double-bank layout (WEAR_LEVELING_DOUBLE_BANK):
+
+        The backing store is split into two banks of half the backing size,
+        each laid out like the single-bank case, with an extra 8 bytes holding
+        a sequence number after the FNV1a_64. The hash also covers the sequence
+        number, and is written last -- a bank is only considered valid once
+        its hash is complete. On startup, the valid bank with the newest
+        sequence number is used, and its write log is played back.
+
+        Consolidation writes to the inactive bank, so the active bank is never
+        erased and a power loss at any point leaves the previous data intact.
+        Once the write log passes WEAR_LEVELING_CONSOLIDATE_THRESHOLD, each call
+        to wear_leveling_task() erases BACKING_STORE_ERASE_SIZE bytes of the
+        inactive bank, or copies WEAR_LEVELING_CONSOLIDATE_STEP_SIZE bytes of
+        the cache into it, before finally committing it. Writes made while the
+        copy is in progress are appended to the write logs of both banks. Should
+        the active write log fill up before background consolidation completes,
+        the remaining steps are performed in-line, as with a single bank. */
 
 /**
  * Storage area for the wear-leveling cache.
@@ -161,9 +182,32 @@
 static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
+#ifdef WEAR_LEVELING_DOUBLE_BANK
+    uint32_t                                                       bank_address;
+    uint32_t                                                       sequence;
+#endif // WEAR_LEVELING_DOUBLE_BANK
     bool                                                           unlocked;
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_DOUBLE_BANK
+#    define WEAR_LEVELING_ACTIVE_BANK (wear_leveling.bank_address)
+#    define WEAR_LEVELING_INACTIVE_BANK ((WEAR_LEVELING_BANK_SIZE)-wear_leveling.bank_address)
+
+/**
+ * Progress of consolidation into the inactive bank.
+ */
+typedef enum wear_leveling_migration_state_t { MIGRATION_IDLE = 0, MIGRATION_ERASE, MIGRATION_COPY, MIGRATION_COMMIT } wear_leveling_migration_state_t;
+
+static struct {
+    wear_leveling_migration_state_t state;
+    uint32_t                        offset;        // Progress within the current state
+    uint32_t                        write_address; // Next write log location within the inactive bank
+    uint64_t                        hash;          // FNV1a_64 of the data copied so far
+} wear_leveling_migration;
+#else
+#    define WEAR_LEVELING_ACTIVE_BANK 0
+#endif // WEAR_LEVELING_DOUBLE_BANK
+
 /**
  * Locking helper: status
  */
@@ -202,9 +246,10 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_LOG_OFFSET);
 }
 
+#ifndef WEAR_LEVELING_DOUBLE_BANK
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -316,10 +361,212 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = (WEAR_LEVELING_LOG_OFFSET);
 
     return status;
 }
+#else  // WEAR_LEVELING_DOUBLE_BANK
+/**
+ * Reads a full 8-byte entry, such as the FNV1a_64 or sequence number, from the backing store.
+ */
+static bool wear_leveling_read_entry(uint32_t address, write_log_entry_t *entry) {
+#    if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#    elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#    elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#    endif
+}
+
+/**
+ * Writes a full 8-byte entry, such as the FNV1a_64 or sequence number, to the backing store.
+ */
+static bool wear_leveling_write_entry(uint32_t address, write_log_entry_t *entry) {
+#    if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#    elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#    elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#    endif
+}
+
+/**
+ * Reads the consolidated data of the supplied bank into the cache, and determines whether the bank is valid.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_bank(uint32_t bank, bool *valid, uint32_t *sequence) {
+    write_log_entry_t hash;
+    write_log_entry_t seq;
+    if (!backing_store_read_bulk(bank, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t)) || !wear_leveling_read_entry(bank + (WEAR_LEVELING_LOGICAL_SIZE), &hash) || !wear_leveling_read_entry(bank + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &seq)) {
+        wl_dprintf("Failed to read from backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // The FNV1a_64 covers both the consolidated data and the sequence number
+    uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+    expected          = fnv_64a_buf(seq.raw8, sizeof(seq), expected);
+
+    *valid    = hash.raw64 == expected && seq.raw32[1] == ~seq.raw32[0];
+    *sequence = seq.raw32[0];
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Selects the newest valid bank, and reads its consolidated data into the cache.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    wl_dprintf("Reading consolidated data\n");
+
+    bool     valid[2];
+    uint32_t sequence[2];
+    for (int i = 0; i < 2; ++i) {
+        if (wear_leveling_read_bank(i * (WEAR_LEVELING_BANK_SIZE), &valid[i], &sequence[i]) == WEAR_LEVELING_FAILED) {
+            wear_leveling_clear_cache();
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+
+    // Sequence numbers are compared such that wraparound is handled
+    int active = (valid[1] && (!valid[0] || (int32_t)(sequence[1] - sequence[0]) > 0)) ? 1 : 0;
+    wl_dprintf("Using bank %d\n", active);
+
+    wear_leveling.bank_address     = active * (WEAR_LEVELING_BANK_SIZE);
+    wear_leveling.sequence         = valid[active] ? sequence[active] : 0;
+    wear_leveling_migration.state  = MIGRATION_IDLE;
+    wear_leveling_migration.offset = 0;
+
+    // If neither bank is valid, clear the cache but do not flag a failure, which will cater for the completely clean MCU case.
+    if (!valid[active]) {
+        wl_dprintf("No valid bank, clearing cache\n");
+        wear_leveling_clear_cache();
+    } else if (active == 0 && wear_leveling_read_bank(0, &valid[0], &sequence[0]) == WEAR_LEVELING_FAILED) {
+        // Bank 1 was read last, so bank 0 needs to be re-read into the cache
+        wear_leveling_clear_cache();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Performs the next step of consolidation into the inactive bank -- erasing a part of it, copying a part of the cache,
+ * or committing it.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the inactive bank has been committed and is now active
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    const uint32_t         bank   = WEAR_LEVELING_INACTIVE_BANK;
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    switch (wear_leveling_migration.state) {
+        case MIGRATION_IDLE:
+            wear_leveling_migration.state  = MIGRATION_ERASE;
+            wear_leveling_migration.offset = 0;
+            // fall through
+
+        case MIGRATION_ERASE:
+            wl_dprintf("Erasing inactive bank\n");
+            if (!backing_store_erase_range(bank + wear_leveling_migration.offset, (BACKING_STORE_ERASE_SIZE))) {
+                wl_dprintf("Failed to erase backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+
+            wear_leveling_migration.offset += (BACKING_STORE_ERASE_SIZE);
+            if (wear_leveling_migration.offset >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling_migration.state         = MIGRATION_COPY;
+                wear_leveling_migration.offset        = 0;
+                wear_leveling_migration.write_address = bank + (WEAR_LEVELING_LOG_OFFSET);
+                wear_leveling_migration.hash          = FNV1A_64_INIT;
+            }
+            break;
+
+        case MIGRATION_COPY: {
+            wl_dprintf("Writing consolidated data\n");
+            uint32_t offset = wear_leveling_migration.offset;
+            uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+            if (length > (WEAR_LEVELING_CONSOLIDATE_STEP_SIZE)) {
+                length = (WEAR_LEVELING_CONSOLIDATE_STEP_SIZE);
+            }
+
+            if (!backing_store_write_bulk(bank + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / sizeof(backing_store_int_t))) {
+                wl_dprintf("Failed to write to backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+
+            // Hash what was actually written, later changes to the cache are caught by the write log of the inactive bank
+            wear_leveling_migration.hash = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling_migration.hash);
+            wear_leveling_migration.offset += length;
+            if (wear_leveling_migration.offset >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling_migration.state = MIGRATION_COMMIT;
+            }
+        } break;
+
+        case MIGRATION_COMMIT: {
+            // Write the sequence number first, the bank only becomes valid once the hash covering it has been written
+            write_log_entry_t seq;
+            write_log_entry_t hash;
+            seq.raw32[0] = wear_leveling.sequence + 1;
+            seq.raw32[1] = ~seq.raw32[0];
+            hash.raw64   = fnv_64a_buf(seq.raw8, sizeof(seq), wear_leveling_migration.hash);
+            wl_dprintf("Writing checksum\n");
+            if (!wear_leveling_write_entry(bank + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &seq) || !wear_leveling_write_entry(bank + (WEAR_LEVELING_LOGICAL_SIZE), &hash)) {
+                wl_dprintf("Failed to write to backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+
+            // Switch over, continuing with the write log entries made during the copy
+            wear_leveling.bank_address    = bank;
+            wear_leveling.write_address   = wear_leveling_migration.write_address;
+            wear_leveling.sequence        = seq.raw32[0];
+            wear_leveling_migration.state = MIGRATION_IDLE;
+            status                        = WEAR_LEVELING_CONSOLIDATED;
+        } break;
+    }
+
+    // On failure, start over with a fresh erase next time around
+    if (status == WEAR_LEVELING_FAILED) {
+        wear_leveling_migration.state = MIGRATION_IDLE;
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+    return status;
+}
+
+/**
+ * Forces a write of the current cache into the inactive bank, and switches over to it.
+ * The active bank is left untouched, so no data is lost if a power loss occurs.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    // This may be invoked part-way through writing a log entry, which would leave the inactive bank's write log with a
+    // partial entry -- so start over from the erase, rather than continuing any background consolidation.
+    wear_leveling_migration.state = MIGRATION_IDLE;
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_consolidate_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
+    if (status == WEAR_LEVELING_FAILED) {
+        wl_dprintf("Failed to write consolidated data\n");
+    }
+    return status;
+}
+#endif // WEAR_LEVELING_DOUBLE_BANK
 
 /**
  * Potential write of the current cache to the backing store.
@@ -329,7 +576,7 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_BANK_SIZE)) {
         return wear_leveling_consolidate_force();
     }
 
@@ -348,6 +595,19 @@ static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value
         return WEAR_LEVELING_FAILED;
     }
     wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
+
+#ifdef WEAR_LEVELING_DOUBLE_BANK
+    // Data already copied to the inactive bank needs this entry in its write log too
+    if (wear_leveling_migration.state >= MIGRATION_COPY) {
+        if (wear_leveling_migration.write_address >= WEAR_LEVELING_INACTIVE_BANK + (WEAR_LEVELING_BANK_SIZE) || !backing_store_write(wear_leveling_migration.write_address, value)) {
+            wl_dprintf("Failed to write to inactive bank, restarting consolidation\n");
+            wear_leveling_migration.state = MIGRATION_IDLE;
+        } else {
+            wear_leveling_migration.write_address += (BACKING_STORE_WRITE_SIZE);
+        }
+    }
+#endif // WEAR_LEVELING_DOUBLE_BANK
+
     return wear_leveling_consolidate_if_needed();
 }
 
@@ -469,18 +729,51 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+/**
+ * Playback helper: a chunk of the write log, loaded using bulk reads.
+ */
+typedef struct wear_leveling_log_chunk_t {
+    backing_store_int_t values[(WEAR_LEVELING_PLAYBACK_BULK_COUNT)];
+    uint32_t            address; // Backing store address of values[0]
+    uint32_t            count;   // Number of values loaded
+} wear_leveling_log_chunk_t;
+
+/**
+ * Reads a single value of the write log, loading the next chunk from the backing store if required.
+ */
+static bool wear_leveling_log_read(wear_leveling_log_chunk_t *chunk, uint32_t address, backing_store_int_t *value) {
+    if (address < chunk->address || address >= chunk->address + chunk->count * (BACKING_STORE_WRITE_SIZE)) {
+        // Don't read past the end of the write log
+        uint32_t count = (WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_BANK_SIZE) - address) / (BACKING_STORE_WRITE_SIZE);
+        if (count > (WEAR_LEVELING_PLAYBACK_BULK_COUNT)) {
+            count = (WEAR_LEVELING_PLAYBACK_BULK_COUNT);
+        }
+
+        chunk->count = 0;
+        if (address >= WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_BANK_SIZE) || !backing_store_read_bulk(address, chunk->values, count)) {
+            return false;
+        }
+        chunk->address = address;
+        chunk->count   = count;
+    }
+
+    *value = chunk->values[(address - chunk->address) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
 static wear_leveling_status_t wear_leveling_playback_log(void) {
     wl_dprintf("Playback write log\n");
 
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    wear_leveling_log_chunk_t chunk           = {.count = 0};
+    wear_leveling_status_t    status          = WEAR_LEVELING_SUCCESS;
+    bool                      cancel_playback = false;
+    uint32_t                  address         = WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_LOG_OFFSET);
+    while (!cancel_playback && address < WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_BANK_SIZE)) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_log_read(&chunk, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +802,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_log_read(&chunk, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +822,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_log_read(&chunk, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +832,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_log_read(&chunk, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +843,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_log_read(&chunk, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -661,6 +954,11 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_DOUBLE_BANK
+    wear_leveling.bank_address    = 0;
+    wear_leveling.sequence        = 0;
+    wear_leveling_migration.state = MIGRATION_IDLE;
+#endif // WEAR_LEVELING_DOUBLE_BANK
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -726,6 +1024,21 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Background consolidation, bounded to a single erase/copy/commit step per invocation.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_DOUBLE_BANK
+    if (wear_leveling_migration.state == MIGRATION_IDLE && wear_leveling.write_address - (WEAR_LEVELING_ACTIVE_BANK + (WEAR_LEVELING_LOG_OFFSET)) < (WEAR_LEVELING_CONSOLIDATE_THRESHOLD)) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    return wear_leveling_consolidate_step();
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_DOUBLE_BANK
+}
+
 /**
  * Reads logical data from the cache.
  */
@@ -52,3 +52,13 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * Performs a bounded amount of background consolidation work.
+ *
+ * Only has an effect with WEAR_LEVELING_DOUBLE_BANK -- once the write log is sufficiently full, each invocation erases
+ * or copies a small part of the inactive bank, and finally switches over to it. Intended to be called while idle.
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED once the switch to the other bank has occurred
+ */
+wear_leveling_status_t wear_leveling_task(void);
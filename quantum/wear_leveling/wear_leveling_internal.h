@@ -66,10 +66,45 @@ _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+// Number of backing store values read at a time when playing back the write log
+#ifndef WEAR_LEVELING_PLAYBACK_BULK_COUNT
+#    define WEAR_LEVELING_PLAYBACK_BULK_COUNT 32
+#endif // WEAR_LEVELING_PLAYBACK_BULK_COUNT
+
+#ifdef WEAR_LEVELING_DOUBLE_BANK
+// The backing store is split into two banks, each with its own consolidated data, header, and write log
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 16) // +16 is due to the FNV1a_64 and sequence number of the consolidated area
+
+// Smallest range the backing store can erase -- defaults to a whole bank
+#    ifndef BACKING_STORE_ERASE_SIZE
+#        define BACKING_STORE_ERASE_SIZE (WEAR_LEVELING_BANK_SIZE)
+#    endif
+
+// Number of bytes of logical data copied into the inactive bank per wear_leveling_task() invocation
+#    ifndef WEAR_LEVELING_CONSOLIDATE_STEP_SIZE
+#        define WEAR_LEVELING_CONSOLIDATE_STEP_SIZE 64
+#    endif
+
+// Number of bytes of write log in use before background consolidation is started
+#    ifndef WEAR_LEVELING_CONSOLIDATE_THRESHOLD
+#        define WEAR_LEVELING_CONSOLIDATE_THRESHOLD (((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOG_OFFSET)) / 2)
+#    endif
+
+_Static_assert(WEAR_LEVELING_BANK_SIZE > WEAR_LEVELING_LOG_OFFSET, "Each bank must fit the logical size, its header, and a write log");
+_Static_assert(WEAR_LEVELING_BANK_SIZE % BACKING_STORE_ERASE_SIZE == 0, "Bank size must be a multiple of erase size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATE_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation step size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATE_THRESHOLD < (WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_OFFSET), "Consolidation threshold must be smaller than the write log");
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_LOG_OFFSET ((WEAR_LEVELING_LOGICAL_SIZE) + 8) // +8 is due to the FNV1a_64 of the consolidated area
+#endif // WEAR_LEVELING_DOUBLE_BANK
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
 bool backing_store_erase(void);
+bool backing_store_erase_range(uint32_t address, size_t length); // only required by WEAR_LEVELING_DOUBLE_BANK, address and length are multiples of BACKING_STORE_ERASE_SIZE
 bool backing_store_write(uint32_t address, backing_store_int_t value);
 bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
 bool backing_store_lock(void);
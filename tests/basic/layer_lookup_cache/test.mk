@@ -0,0 +1,5 @@
+# Copyright 2022 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Runs the layer tests against the layer lookup cache
+SRC += tests/basic/test_action_layer.cpp
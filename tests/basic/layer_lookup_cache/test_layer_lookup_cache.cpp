@@ -0,0 +1,73 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class LayerLookupCache : public TestFixture {};
+
+TEST_F(LayerLookupCache, ResolvesThroughTransparentLayers) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B), KeymapKey(2, 0, 0, KC_TRNS), KeymapKey(3, 0, 0, KC_TRNS)});
+
+    layer_state_set(0b1101);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* Turning on a layer below the topmost one */
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    /* Turning off a layer above the resolved one */
+    layer_off(3);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    /* Turning off the resolved layer */
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(LayerLookupCache, FallsBackToLayerZero) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(2, 0, 0, KC_C)});
+
+    layer_move(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+}
+
+TEST_F(LayerLookupCache, InvalidatedByKeymapChange) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 1, 1, KC_A);
+
+    set_keymap({key_a, KeymapKey(1, 1, 1, KC_TRNS)});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    /* add_key() invalidates the cache, as a VIA edit would */
+    set_keymap({key_a, KeymapKey(1, 1, 1, KC_B)});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,61 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_common.hpp"
+#include "benchmark.hpp"
+
+extern "C" {
+#include "color.h"
+}
+
+namespace {
+/* Matches the default RGB_MATRIX_HSV_BATCH_SIZE of the effect runners. */
+constexpr size_t batch_size = 16;
+constexpr size_t frame_size = 128;
+constexpr int    frames     = 20000;
+} // namespace
+
+/* Converts a frame worth of LEDs, in groups the size of an effect runner
+ * batch, either one LED at a time or with a single batched call per group. */
+class ColorConversion : public BenchmarkFixture {
+   public:
+    ColorConversion() : m_hsv(frame_size), m_rgb(frame_size) {
+        for (size_t i = 0; i < frame_size; i++) {
+            m_hsv[i] = {(uint8_t)(i * 7), (uint8_t)(255 - i), (uint8_t)(128 + i)};
+        }
+    }
+
+    void convert_frames(bool batched) {
+        for (int frame = 0; frame < frames; frame++) {
+            m_hsv[frame % frame_size].h++;
+            for (size_t i = 0; i < frame_size; i += batch_size) {
+                if (batched) {
+                    BENCHMARK_PROBE_ENTER(HSV_TO_RGB_BATCH);
+                    hsv_to_rgb_batch(&m_hsv[i], &m_rgb[i], batch_size);
+                    BENCHMARK_PROBE_EXIT(HSV_TO_RGB_BATCH);
+                } else {
+                    BENCHMARK_PROBE_ENTER(HSV_TO_RGB);
+                    for (size_t j = i; j < i + batch_size; j++) {
+                        m_rgb[j] = hsv_to_rgb(m_hsv[j]);
+                    }
+                    BENCHMARK_PROBE_EXIT(HSV_TO_RGB);
+                }
+            }
+        }
+    }
+
+   protected:
+    std::vector<HSV> m_hsv;
+    std::vector<RGB> m_rgb;
+};
+
+TEST_F(ColorConversion, PerLed) {
+    convert_frames(false);
+    EXPECT_EQ(probe_stats(BENCHMARK_PROBE_HSV_TO_RGB).count(), frames * frame_size / batch_size);
+}
+
+TEST_F(ColorConversion, Batched) {
+    convert_frames(true);
+    EXPECT_EQ(probe_stats(BENCHMARK_PROBE_HSV_TO_RGB_BATCH).count(), frames * frame_size / batch_size);
+}
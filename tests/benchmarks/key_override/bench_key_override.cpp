@@ -0,0 +1,172 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "benchmark.hpp"
+
+extern "C" {
+const key_override_t **key_overrides = NULL;
+}
+
+namespace {
+// clang-format off
+const uint16_t base_layer[4][MATRIX_COLS] = {
+    {KC_Q,    KC_W,    KC_E,    KC_R,    KC_T,   KC_Y,   KC_U, KC_I, KC_O, KC_P},
+    {KC_A,    KC_S,    KC_D,    KC_F,    KC_G,   KC_H,   KC_J, KC_K, KC_L, KC_1},
+    {KC_Z,    KC_X,    KC_C,    KC_V,    KC_B,   KC_N,   KC_M, KC_2, KC_3, KC_4},
+    {KC_LSFT, KC_LCTL, KC_LALT, KC_LGUI, KC_SPC, KC_SPC, KC_5, KC_6, KC_7, KC_8},
+};
+
+const uint8_t override_mods[] = {
+    MOD_MASK_SHIFT, MOD_MASK_CTRL, MOD_MASK_ALT, MOD_MASK_GUI, MOD_MASK_CS,
+    MOD_MASK_CA,    MOD_MASK_CG,   MOD_MASK_SA,  MOD_MASK_SG,  MOD_MASK_AG,
+};
+// clang-format on
+
+const char *corpus =
+    "the quick brown fox jumps over the lazy dog "
+    "pack my box with five dozen liquor jugs "
+    "how vexingly quick daft zebras jump "
+    "sphinx of black quartz judge my vow";
+} // namespace
+
+/* Builds a table with an override for every letter and digit on the keymap,
+ * per entry of override_mods. The table is ordered by modifiers first, so the
+ * overrides of one trigger are spread across the whole table. */
+class KeyOverrideTable : public BenchmarkFixture {
+   public:
+    void set_up_table(size_t mod_count) {
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, base_layer[row][col]));
+            }
+        }
+
+        m_overrides.clear();
+        for (size_t i = 0; i < mod_count; i++) {
+            for (uint8_t row = 0; row < 3; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    key_override_t override  = {};
+                    override.trigger         = base_layer[row][col];
+                    override.trigger_mods    = override_mods[i];
+                    override.layers          = ~0;
+                    override.suppressed_mods = override_mods[i];
+                    override.replacement     = KC_F1 + (i % 12);
+                    override.options         = ko_options_default;
+                    m_overrides.push_back(override);
+                }
+            }
+        }
+
+        m_table.clear();
+        for (const auto &override : m_overrides) {
+            m_table.push_back(&override);
+        }
+        m_table.push_back(NULL);
+        key_overrides = m_table.data();
+    }
+
+    ~KeyOverrideTable() {
+        key_overrides = NULL;
+    }
+
+    KeymapKey key_at(uint8_t col, uint8_t row) {
+        return KeymapKey(0, col, row, base_layer[row][col]);
+    }
+
+    std::vector<KeymapKey> keys_for(const char *text) {
+        std::vector<KeymapKey> keys;
+        for (; *text; text++) {
+            keys.push_back(key_for(*text));
+        }
+        return keys;
+    }
+
+    /* Types the corpus plainly, then holding each modifier in turn, so that
+     * most keys activate an override. */
+    void type_corpus_with_mods() {
+        auto keys = keys_for(corpus);
+
+        type_keys(keys, 30, 40);
+        for (uint8_t col = 0; col < 4; col++) {
+            KeymapKey mod = key_at(col, 3);
+            mod.press();
+            idle_for(30);
+            type_keys(keys, 30, 40);
+            mod.release();
+            idle_for(30);
+        }
+    }
+
+    /* Holds a key and taps each modifier, activating and deactivating overrides
+     * on the modifier events alone. */
+    void tap_mods_over_keys() {
+        for (const auto &key : keys_for("asdfjkl")) {
+            KeymapKey held = key;
+            held.press();
+            idle_for(30);
+            for (uint8_t col = 0; col < 4; col++) {
+                type_keys({key_at(col, 3)}, 30, 40);
+            }
+            held.release();
+            idle_for(30);
+        }
+    }
+
+   private:
+    KeymapKey key_for(char c) {
+        uint16_t keycode = c == ' ' ? KC_SPC : KC_A + (c - 'a');
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                if (base_layer[row][col] == keycode) {
+                    return key_at(col, row);
+                }
+            }
+        }
+        ADD_FAILURE() << "No key for character '" << c << "'";
+        return key_at(4, 3);
+    }
+
+    std::vector<key_override_t>         m_overrides;
+    std::vector<const key_override_t *> m_table;
+};
+
+/* 120 overrides, which fit in the lookup index. */
+TEST_F(KeyOverrideTable, TypingWithMods120) {
+    set_up_table(4);
+    for (int i = 0; i < 5; i++) {
+        type_corpus_with_mods();
+    }
+
+    EXPECT_GT(reports_sent(), 0);
+}
+
+TEST_F(KeyOverrideTable, TappingMods120) {
+    set_up_table(4);
+    for (int i = 0; i < 20; i++) {
+        tap_mods_over_keys();
+    }
+
+    EXPECT_GT(reports_sent(), 0);
+}
+
+/* 300 overrides, more than the lookup index holds, which are searched linearly. */
+TEST_F(KeyOverrideTable, TypingWithMods300) {
+    set_up_table(10);
+    for (int i = 0; i < 5; i++) {
+        type_corpus_with_mods();
+    }
+
+    EXPECT_GT(reports_sent(), 0);
+}
+
+TEST_F(KeyOverrideTable, TappingMods300) {
+    set_up_table(10);
+    for (int i = 0; i < 20; i++) {
+        tap_mods_over_keys();
+    }
+
+    EXPECT_GT(reports_sent(), 0);
+}
@@ -0,0 +1,131 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <string>
+#include <vector>
+#include "keycode.h"
+#include "test_common.hpp"
+#include "benchmark.hpp"
+
+namespace {
+// clang-format off
+const uint16_t base_layer[4][MATRIX_COLS] = {
+    {KC_Q,         KC_W,         KC_E,         KC_R,         KC_T,    KC_Y,   KC_U,         KC_I,         KC_O,         KC_P},
+    {LGUI_T(KC_A), LALT_T(KC_S), LCTL_T(KC_D), LSFT_T(KC_F), KC_G,    KC_H,   RSFT_T(KC_J), RCTL_T(KC_K), LALT_T(KC_L), RGUI_T(KC_SCLN)},
+    {KC_Z,         KC_X,         KC_C,         KC_V,         KC_B,    KC_N,   KC_M,         KC_COMM,      KC_DOT,       KC_SLSH},
+    {KC_LCTL,      KC_LSFT,      KC_LALT,      MO(1),        KC_SPC,  KC_SPC, MO(2),        KC_RALT,      KC_RSFT,      KC_RCTL},
+};
+// clang-format on
+
+const char *corpus =
+    "the quick brown fox jumps over the lazy dog. "
+    "pack my box with five dozen liquor jugs, "
+    "how vexingly quick daft zebras jump. "
+    "sphinx of black quartz, judge my vow.";
+
+const char *rolls[] = {"the", "ing", "ion", "and", "tion", "ould", "ight", "ough"};
+} // namespace
+
+class ScanLoop : public BenchmarkFixture {
+   public:
+    ScanLoop() {
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, base_layer[row][col]));
+                /* Upper layers only remap the top row, everything else falls through. */
+                add_key(KeymapKey(1, col, row, row == 0 ? (uint16_t)(KC_1 + col) : (uint16_t)KC_TRNS));
+                add_key(KeymapKey(2, col, row, row == 0 ? (uint16_t)(KC_F1 + col) : (uint16_t)KC_TRNS));
+            }
+        }
+    }
+
+    KeymapKey key_at(uint8_t col, uint8_t row) {
+        return KeymapKey(0, col, row, base_layer[row][col]);
+    }
+
+    std::vector<KeymapKey> keys_for(const std::string &text) {
+        std::vector<KeymapKey> keys;
+        for (char c : text) {
+            keys.push_back(key_for(c));
+        }
+        return keys;
+    }
+
+   private:
+    KeymapKey key_for(char c) {
+        static const std::map<char, uint16_t> symbols = {{' ', KC_SPC}, {',', KC_COMM}, {'.', KC_DOT}, {';', KC_SCLN}, {'/', KC_SLSH}};
+
+        uint16_t keycode = (c >= 'a' && c <= 'z') ? KC_A + (c - 'a') : symbols.at(c);
+        for (uint8_t row = 0; row < 4; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint16_t code = base_layer[row][col];
+                if (IS_QK_MOD_TAP(code)) {
+                    code = QK_MOD_TAP_GET_TAP_KEYCODE(code);
+                }
+                if (code == keycode) {
+                    return key_at(col, row);
+                }
+            }
+        }
+        ADD_FAILURE() << "No key for character '" << c << "'";
+        return key_at(4, 3);
+    }
+};
+
+TEST_F(ScanLoop, Idle) {
+    idle_for(10000);
+}
+
+TEST_F(ScanLoop, TypingCorpus) {
+    auto keys = keys_for(corpus);
+
+    for (int i = 0; i < 10; i++) {
+        type_keys(keys, 30, 40);
+    }
+
+    EXPECT_GT(reports_sent(), 0);
+}
+
+TEST_F(ScanLoop, FastRolls) {
+    for (int i = 0; i < 50; i++) {
+        for (const char *word : rolls) {
+            roll_keys(keys_for(word), 15, 10);
+            idle_for(50);
+        }
+    }
+
+    EXPECT_GT(reports_sent(), 0);
+}
+
+TEST_F(ScanLoop, Chords) {
+    const std::vector<std::vector<KeymapKey>> chords = {
+        {key_at(0, 3), key_at(2, 0)},
+        {key_at(0, 3), key_at(1, 3), key_at(3, 0)},
+        {key_at(0, 3), key_at(1, 3), key_at(2, 3), key_at(9, 0)},
+        {key_at(4, 0), key_at(5, 0), key_at(6, 0), key_at(7, 0), key_at(8, 0), key_at(9, 0)},
+    };
+
+    for (int i = 0; i < 200; i++) {
+        for (const auto &chord : chords) {
+            chord_keys(chord, 30);
+        }
+    }
+
+    EXPECT_GT(reports_sent(), 0);
+}
+
+TEST_F(ScanLoop, TransparentLayers) {
+    KeymapKey layer_key = key_at(3, 3);
+    auto      keys      = keys_for("qwertyuiop zxcvbnm");
+
+    for (int i = 0; i < 20; i++) {
+        layer_key.press();
+        idle_for(30);
+        type_keys(keys, 20, 20);
+        layer_key.release();
+        idle_for(30);
+    }
+
+    EXPECT_GT(reports_sent(), 0);
+}
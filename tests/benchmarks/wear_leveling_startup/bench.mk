@@ -0,0 +1,8 @@
+# Copyright 2022 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+WEAR_LEVELING_DRIVER = custom
+
+VPATH += $(QUANTUM_DIR)/wear_leveling/tests
+
+SRC += $(QUANTUM_DIR)/wear_leveling/tests/backing_mocks.cpp
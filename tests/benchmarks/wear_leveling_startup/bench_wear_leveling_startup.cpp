@@ -0,0 +1,62 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <numeric>
+#include "test_common.hpp"
+#include "benchmark.hpp"
+#include "backing_mocks.hpp"
+
+namespace {
+constexpr int inits = 2000;
+} // namespace
+
+/* Replays the write log at startup, either right after consolidation or with
+ * the log filled up to the point where the next write would consolidate it. */
+class WearLevelingStartup : public BenchmarkFixture {
+   public:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    void fill_log() {
+        auto&             inst         = MockBackingStore::Instance();
+        const std::size_t log_capacity = (WEAR_LEVELING_BACKING_SIZE) - (WEAR_LEVELING_LOG_OFFSET);
+        for (std::uint32_t i = 0; (inst.write_invoke_count() + 4) * (BACKING_STORE_WRITE_SIZE) < log_capacity; ++i) {
+            std::uint8_t value[5];
+            std::iota(value, value + 5, i);
+            // Mix of single-byte, word, and multi-byte writes
+            switch (i % 3) {
+                case 0:
+                    wear_leveling_write(i % 64, value, 1);
+                    break;
+                case 1:
+                    wear_leveling_write((i * 2) % 1024, value, 2);
+                    break;
+                default:
+                    wear_leveling_write(64 + (i * 7) % ((WEAR_LEVELING_LOGICAL_SIZE) - 64 - 5), value, 5);
+                    break;
+            }
+        }
+    }
+
+    void run_inits() {
+        for (int i = 0; i < inits; i++) {
+            BENCHMARK_PROBE_ENTER(WEAR_LEVELING_INIT);
+            wear_leveling_status_t status = wear_leveling_init();
+            BENCHMARK_PROBE_EXIT(WEAR_LEVELING_INIT);
+            ASSERT_EQ(status, WEAR_LEVELING_SUCCESS);
+        }
+    }
+};
+
+TEST_F(WearLevelingStartup, EmptyLog) {
+    run_inits();
+    EXPECT_EQ(probe_stats(BENCHMARK_PROBE_WEAR_LEVELING_INIT).count(), inits);
+}
+
+TEST_F(WearLevelingStartup, FullLog) {
+    fill_log();
+    run_inits();
+    EXPECT_EQ(probe_stats(BENCHMARK_PROBE_WEAR_LEVELING_INIT).count(), inits);
+}
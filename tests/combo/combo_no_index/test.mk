@@ -0,0 +1,7 @@
+# Copyright 2022 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Runs the combo tests against the linear combo scan
+COMBO_ENABLE = yes
+
+SRC += tests/combo/test_combo.cpp
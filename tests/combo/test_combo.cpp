@@ -0,0 +1,212 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// These tests are run both with the combo key index and with COMBO_NO_INDEX,
+// which must behave identically.
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+enum combo_events { AB_COMBO, BC_COMBO, ABC_COMBO, FG_COMBO, FH_COMBO, GH_COMBO, FGH_COMBO, DUP_COMBO, ACTION_COMBO, COMBO_LENGTH };
+uint16_t COMBO_LEN = COMBO_LENGTH;
+
+const uint16_t ab_combo[] PROGMEM     = {KC_A, KC_B, COMBO_END};
+const uint16_t bc_combo[] PROGMEM     = {KC_B, KC_C, COMBO_END};
+const uint16_t abc_combo[] PROGMEM    = {KC_A, KC_B, KC_C, COMBO_END};
+const uint16_t fg_combo[] PROGMEM     = {KC_F, KC_G, COMBO_END};
+const uint16_t fh_combo[] PROGMEM     = {KC_F, KC_H, COMBO_END};
+const uint16_t gh_combo[] PROGMEM     = {KC_G, KC_H, COMBO_END};
+const uint16_t fgh_combo[] PROGMEM    = {KC_F, KC_G, KC_H, COMBO_END};
+const uint16_t dup_combo[] PROGMEM    = {KC_J, KC_J, KC_K, COMBO_END};
+const uint16_t action_combo[] PROGMEM = {KC_K, KC_L, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    [AB_COMBO]     = COMBO(ab_combo, KC_SPC),
+    [BC_COMBO]     = COMBO(bc_combo, KC_X),
+    [ABC_COMBO]    = COMBO(abc_combo, KC_ESC),
+    [FG_COMBO]     = COMBO(fg_combo, KC_1),
+    [FH_COMBO]     = COMBO(fh_combo, KC_2),
+    [GH_COMBO]     = COMBO(gh_combo, KC_3),
+    [FGH_COMBO]    = COMBO(fgh_combo, KC_4),
+    [DUP_COMBO]    = COMBO(dup_combo, KC_5),
+    [ACTION_COMBO] = COMBO_ACTION(action_combo),
+};
+// clang-format on
+
+static uint16_t action_combo_presses = 0;
+
+void process_combo_event(uint16_t combo_index, bool pressed) {
+    if (combo_index == ACTION_COMBO && pressed) {
+        action_combo_presses++;
+    }
+}
+} // extern "C"
+
+class Combo : public TestFixture {
+   public:
+    Combo() {
+        combo_enable();
+        action_combo_presses = 0;
+    }
+};
+
+TEST_F(Combo, TwoKeyComboTriggers) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_SPC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    idle_for(COMBO_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, LongerOverlappingComboWins) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    KeymapKey  key_c(0, 2, 0, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    EXPECT_REPORT(driver, (KC_ESC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b, key_c});
+    idle_for(COMBO_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, SharedKeyPicksMatchingCombo) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_f(0, 0, 1, KC_F);
+    KeymapKey  key_g(0, 1, 1, KC_G);
+    KeymapKey  key_h(0, 2, 1, KC_H);
+    set_keymap({key_f, key_g, key_h});
+
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_4));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_f, key_h});
+    idle_for(COMBO_TERM);
+    tap_combo({key_h, key_g});
+    idle_for(COMBO_TERM);
+    tap_combo({key_g, key_h, key_f});
+    idle_for(COMBO_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, NonComboKeyIsNotDelayed) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_z(0, 0, 2, KC_Z);
+    set_keymap({key_z});
+
+    EXPECT_REPORT(driver, (KC_Z));
+    key_z.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_z.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, IncompleteComboTimesOut) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_NO_REPORT(driver);
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    idle_for(COMBO_TERM + 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The combo state was reset, so the combo still works afterwards
+    EXPECT_REPORT(driver, (KC_SPC));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_b, key_a});
+    idle_for(COMBO_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, ComboKeysTypedWhenDisabled) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_a, key_b});
+
+    combo_disable();
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, RepeatedKeyInCombo) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_j(0, 3, 0, KC_J);
+    KeymapKey  key_k(0, 4, 0, KC_K);
+    set_keymap({key_j, key_k});
+
+    // A combo listing a key twice can never be completed, its keys are typed after the combo term
+    EXPECT_REPORT(driver, (KC_J));
+    EXPECT_REPORT(driver, (KC_J, KC_K));
+    EXPECT_REPORT(driver, (KC_K));
+    EXPECT_EMPTY_REPORT(driver);
+    key_j.press();
+    run_one_scan_loop();
+    key_k.press();
+    run_one_scan_loop();
+    idle_for(COMBO_TERM + 1);
+    key_j.release();
+    run_one_scan_loop();
+    key_k.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Combo, ComboAction) {
+    TestDriver driver;
+    KeymapKey  key_k(0, 4, 0, KC_K);
+    KeymapKey  key_l(0, 5, 0, KC_L);
+    set_keymap({key_k, key_l});
+
+    EXPECT_NO_REPORT(driver);
+    tap_combo({key_k, key_l});
+    idle_for(COMBO_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(action_combo_presses, 1);
+}
@@ -0,0 +1,9 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// More executors than fit twice into the 8-bit token range
+#define MAX_DEFERRED_EXECUTORS 200
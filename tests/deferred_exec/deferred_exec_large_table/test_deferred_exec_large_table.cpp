@@ -0,0 +1,105 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+std::vector<int> invocations;
+
+uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back(*static_cast<int *>(cb_arg));
+    return 0;
+}
+
+int            first_id = 0, second_id = 1;
+deferred_token redeferred_token;
+
+uint32_t redefer_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back(-1);
+    // Cancelling itself frees the slot, which the new executor then takes over
+    cancel_deferred_exec(*static_cast<deferred_token *>(cb_arg));
+    redeferred_token = defer_exec(30, record_callback, &second_id);
+    return 10;
+}
+} // namespace
+
+class DeferredExecLargeTable : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        invocations.clear();
+        // Time keeps moving forward between tests, as the task throttles itself against the last execution time
+        advance_time(1000);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+};
+
+TEST_F(DeferredExecLargeTable, StaleTokenIsNotReissued) {
+    deferred_token stale = defer_exec(10, record_callback, &first_id);
+    ASSERT_NE(stale, INVALID_DEFERRED_TOKEN);
+    EXPECT_TRUE(cancel_deferred_exec(stale));
+
+    // The freed slot is reused, but with a new token
+    deferred_token fresh = defer_exec(10, record_callback, &second_id);
+    ASSERT_NE(fresh, INVALID_DEFERRED_TOKEN);
+    EXPECT_NE(fresh, stale);
+
+    EXPECT_FALSE(extend_deferred_exec(stale, 50));
+    EXPECT_FALSE(cancel_deferred_exec(stale));
+
+    run_for(20);
+    ASSERT_EQ(invocations.size(), 1u);
+    EXPECT_EQ(invocations[0], second_id);
+}
+
+TEST_F(DeferredExecLargeTable, TokensAreUniqueWhenFull) {
+    std::vector<deferred_token> tokens;
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        tokens.push_back(defer_exec(100, record_callback, &first_id));
+        ASSERT_NE(tokens.back(), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec(100, record_callback, &first_id), INVALID_DEFERRED_TOKEN);
+
+    // Freeing one executor and queueing another never reissues a token which is still in use
+    for (int i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        ASSERT_TRUE(cancel_deferred_exec(tokens[i]));
+        deferred_token token = defer_exec(100, record_callback, &first_id);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        for (int j = 0; j < MAX_DEFERRED_EXECUTORS; j++) {
+            ASSERT_TRUE(j == i || tokens[j] != token) << "token " << (int)token << " reissued while in use";
+        }
+        tokens[i] = token;
+    }
+
+    for (auto token : tokens) {
+        EXPECT_TRUE(cancel_deferred_exec(token));
+    }
+}
+
+TEST_F(DeferredExecLargeTable, CallbackCancelsItselfAndDefersAgain) {
+    deferred_token token = defer_exec(10, redefer_callback, &token);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+
+    run_for(10);
+    ASSERT_EQ(invocations.size(), 1u);
+
+    // The cancelled callback is not repeated, and the executor that took over its slot keeps its own delay
+    run_for(30);
+    ASSERT_EQ(invocations.size(), 2u);
+    EXPECT_EQ(invocations[0], -1);
+    EXPECT_EQ(invocations[1], second_id);
+    EXPECT_FALSE(cancel_deferred_exec(redeferred_token));
+}
@@ -0,0 +1,181 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+struct Invocation {
+    int      id;
+    uint32_t trigger_time;
+};
+
+std::vector<Invocation> invocations;
+
+const size_t TABLE_SIZE = 16;
+
+struct CallbackArg {
+    int      id;
+    uint32_t repeat_ms;
+};
+
+uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    CallbackArg *arg = static_cast<CallbackArg *>(cb_arg);
+    invocations.push_back({arg->id, trigger_time});
+    return arg->repeat_ms;
+}
+} // namespace
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        invocations.clear();
+        set_time(1000);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, TABLE_SIZE, &last_exec);
+        }
+    }
+
+    deferred_token queue(CallbackArg *arg, uint32_t delay_ms) {
+        return defer_exec_advanced(table, TABLE_SIZE, delay_ms, record_callback, arg);
+    }
+
+    deferred_executor_t table[TABLE_SIZE] = {};
+    uint32_t            last_exec         = 0;
+};
+
+TEST_F(DeferredExec, ExecutesInTriggerOrder) {
+    CallbackArg args[] = {{0, 0}, {1, 0}, {2, 0}, {3, 0}};
+    uint32_t    delays[] = {40, 10, 30, 20};
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_NE(queue(&args[i], delays[i]), INVALID_DEFERRED_TOKEN);
+    }
+
+    uint32_t next;
+    ASSERT_TRUE(deferred_exec_advanced_next_deadline(table, TABLE_SIZE, &next));
+    EXPECT_EQ(next, 1010u);
+
+    run_for(50);
+
+    ASSERT_EQ(invocations.size(), 4u);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[1].id, 3);
+    EXPECT_EQ(invocations[2].id, 2);
+    EXPECT_EQ(invocations[3].id, 0);
+    EXPECT_EQ(invocations[0].trigger_time, 1010u);
+    EXPECT_EQ(invocations[3].trigger_time, 1040u);
+
+    EXPECT_FALSE(deferred_exec_advanced_next_deadline(table, TABLE_SIZE, &next));
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToTriggerTime) {
+    CallbackArg arg = {0, 25};
+    queue(&arg, 10);
+
+    run_for(100);
+
+    ASSERT_EQ(invocations.size(), 4u);
+    for (size_t i = 0; i < invocations.size(); i++) {
+        EXPECT_EQ(invocations[i].trigger_time, 1010u + 25 * i);
+    }
+
+    uint32_t next;
+    ASSERT_TRUE(deferred_exec_advanced_next_deadline(table, TABLE_SIZE, &next));
+    EXPECT_EQ(next, 1110u);
+}
+
+TEST_F(DeferredExec, CancelAndExtend) {
+    CallbackArg    args[] = {{0, 0}, {1, 0}, {2, 0}};
+    deferred_token tokens[3];
+    for (int i = 0; i < 3; i++) {
+        tokens[i] = queue(&args[i], 10 * (i + 1));
+    }
+
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, tokens[0]));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, tokens[0]));
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, tokens[1], 50));
+
+    uint32_t next;
+    ASSERT_TRUE(deferred_exec_advanced_next_deadline(table, TABLE_SIZE, &next));
+    EXPECT_EQ(next, 1030u);
+
+    run_for(60);
+
+    ASSERT_EQ(invocations.size(), 2u);
+    EXPECT_EQ(invocations[0].id, 2);
+    EXPECT_EQ(invocations[1].id, 1);
+    EXPECT_EQ(invocations[1].trigger_time, 1050u);
+
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_SIZE, tokens[1], 50));
+}
+
+TEST_F(DeferredExec, TableFull) {
+    std::vector<CallbackArg>    args(TABLE_SIZE + 1);
+    std::vector<deferred_token> tokens;
+
+    for (size_t i = 0; i < TABLE_SIZE; i++) {
+        args[i] = {(int)i, 0};
+        tokens.push_back(queue(&args[i], 100 - i));
+        EXPECT_NE(tokens.back(), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(queue(&args[TABLE_SIZE], 5), INVALID_DEFERRED_TOKEN);
+
+    // All tokens are unique
+    std::vector<deferred_token> sorted = tokens;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    // Freeing a slot makes room for a new executor
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, tokens[3]));
+    args[TABLE_SIZE] = {(int)TABLE_SIZE, 0};
+    EXPECT_NE(queue(&args[TABLE_SIZE], 5), INVALID_DEFERRED_TOKEN);
+
+    run_for(100);
+
+    ASSERT_EQ(invocations.size(), TABLE_SIZE);
+    EXPECT_EQ(invocations.front().id, (int)TABLE_SIZE);
+    for (size_t i = 1; i < invocations.size(); i++) {
+        EXPECT_LE(invocations[i - 1].trigger_time, invocations[i].trigger_time);
+    }
+}
+
+namespace {
+deferred_executor_t *self_cancel_table;
+deferred_token       self_cancel_token;
+
+uint32_t self_cancel_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({-1, trigger_time});
+    cancel_deferred_exec_advanced(self_cancel_table, TABLE_SIZE, self_cancel_token);
+    return 10;
+}
+} // namespace
+
+TEST_F(DeferredExec, CallbackCancelsItself) {
+    CallbackArg arg = {0, 0};
+    self_cancel_table = table;
+    self_cancel_token = defer_exec_advanced(table, TABLE_SIZE, 10, self_cancel_callback, NULL);
+    queue(&arg, 20);
+
+    run_for(50);
+
+    ASSERT_EQ(invocations.size(), 2u);
+    EXPECT_EQ(invocations[0].id, -1);
+    EXPECT_EQ(invocations[1].id, 0);
+
+    uint32_t next;
+    EXPECT_FALSE(deferred_exec_advanced_next_deadline(table, TABLE_SIZE, &next));
+}
@@ -0,0 +1,13 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Large enough for the dynamic keymap of the test matrix
+#define TEST_EEPROM_SIZE 1024
+
+#define DYNAMIC_KEYMAP_RAM_CACHE
+#define DYNAMIC_KEYMAP_WRITE_BACK_DELAY 500
+#define DYNAMIC_KEYMAP_WRITE_BACK_BATCH 4
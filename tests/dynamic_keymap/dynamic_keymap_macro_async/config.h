@@ -0,0 +1,14 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TEST_EEPROM_SIZE 1024
+
+#define SEND_STRING_ASYNC_ENABLE
+
+// A small macro buffer, followed by EEPROM the macros must not reach into
+#define DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR 512
+#define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE 16
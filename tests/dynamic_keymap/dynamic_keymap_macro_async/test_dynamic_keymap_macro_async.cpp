@@ -0,0 +1,48 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+
+extern "C" {
+#include "eeprom.h"
+#include "dynamic_keymap.h"
+#include "send_string.h"
+}
+
+using testing::InSequence;
+
+class DynamicKeymapMacroAsync : public TestFixture {};
+
+TEST_F(DynamicKeymapMacroAsync, StopsAtTheEndOfTheBuffer) {
+    TestDriver driver;
+    InSequence s;
+
+    // The first macro fills the whole buffer, and the EEPROM after it holds another string
+    char macro[DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE] = {0};
+    memset(macro, 'a', sizeof(macro) - 1);
+    dynamic_keymap_macro_reset();
+    dynamic_keymap_macro_set_buffer(0, sizeof(macro), (uint8_t *)macro);
+    eeprom_write_byte((uint8_t *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE), 'b');
+    eeprom_write_byte((uint8_t *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE + 1), 0);
+
+    dynamic_keymap_macro_send(0);
+    EXPECT_TRUE(send_string_async_is_busy());
+
+    // The terminator is overwritten while the macro is being typed out
+    uint8_t last = 'a';
+    dynamic_keymap_macro_set_buffer(sizeof(macro) - 1, 1, &last);
+
+    for (size_t i = 0; i < sizeof(macro); i++) {
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    for (unsigned loops = 0; send_string_async_is_busy() && loops < 1000; loops++) {
+        run_one_scan_loop();
+    }
+    EXPECT_FALSE(send_string_async_is_busy());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
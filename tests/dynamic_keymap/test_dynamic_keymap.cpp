@@ -0,0 +1,136 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "keycode.h"
+#include "quantum_keycodes.h"
+#include "eeprom.h"
+#include "dynamic_keymap.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+    return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+}
+} // namespace
+
+class DynamicKeymapCache : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        dynamic_keymap_reset();
+        dynamic_keymap_init();
+    }
+};
+
+TEST_F(DynamicKeymapCache, SetKeycodeOnlyUpdatesRam) {
+    dynamic_keymap_set_keycode(1, 2, 3, KC_A);
+
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), KC_A);
+    EXPECT_EQ(eeprom_keycode(1, 2, 3), KC_TRANSPARENT);
+}
+
+TEST_F(DynamicKeymapCache, WriteBackWaitsForDelay) {
+    dynamic_keymap_set_keycode(1, 2, 3, KC_A);
+
+    advance_time(DYNAMIC_KEYMAP_WRITE_BACK_DELAY - 1);
+    dynamic_keymap_task();
+    EXPECT_EQ(eeprom_keycode(1, 2, 3), KC_TRANSPARENT);
+
+    // Further changes restart the delay
+    dynamic_keymap_set_keycode(1, 2, 4, KC_B);
+    advance_time(DYNAMIC_KEYMAP_WRITE_BACK_DELAY - 1);
+    dynamic_keymap_task();
+    EXPECT_EQ(eeprom_keycode(1, 2, 3), KC_TRANSPARENT);
+
+    advance_time(1);
+    dynamic_keymap_task();
+    EXPECT_EQ(eeprom_keycode(1, 2, 3), KC_A);
+    EXPECT_EQ(eeprom_keycode(1, 2, 4), KC_B);
+}
+
+TEST_F(DynamicKeymapCache, WriteBackIsBatched) {
+    for (uint8_t column = 0; column <= DYNAMIC_KEYMAP_WRITE_BACK_BATCH; column++) {
+        dynamic_keymap_set_keycode(2, 0, column, KC_A + column);
+    }
+
+    advance_time(DYNAMIC_KEYMAP_WRITE_BACK_DELAY);
+    dynamic_keymap_task();
+    for (uint8_t column = 0; column < DYNAMIC_KEYMAP_WRITE_BACK_BATCH; column++) {
+        EXPECT_EQ(eeprom_keycode(2, 0, column), KC_A + column);
+    }
+    EXPECT_EQ(eeprom_keycode(2, 0, DYNAMIC_KEYMAP_WRITE_BACK_BATCH), KC_TRANSPARENT);
+
+    dynamic_keymap_task();
+    EXPECT_EQ(eeprom_keycode(2, 0, DYNAMIC_KEYMAP_WRITE_BACK_BATCH), KC_A + DYNAMIC_KEYMAP_WRITE_BACK_BATCH);
+}
+
+TEST_F(DynamicKeymapCache, FlushWritesEverything) {
+    for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+        dynamic_keymap_set_keycode(3, 1, column, KC_1 + column);
+    }
+
+    dynamic_keymap_flush();
+    for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+        EXPECT_EQ(eeprom_keycode(3, 1, column), KC_1 + column);
+    }
+}
+
+TEST_F(DynamicKeymapCache, InitLoadsFromEeprom) {
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(0, 1, 1);
+    eeprom_update_byte(address, KC_Q >> 8);
+    eeprom_update_byte(address + 1, KC_Q & 0xFF);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_NO);
+
+    dynamic_keymap_init();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_Q);
+}
+
+TEST_F(DynamicKeymapCache, BufferAccessUsesRam) {
+    // Keycode at layer 0, row 0, column 1 starts at byte offset 2
+    uint8_t data[3] = {0x00, LCTL(KC_C) >> 8, LCTL(KC_C) & 0xFF};
+    dynamic_keymap_set_buffer(1, sizeof(data), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), LCTL(KC_C));
+    EXPECT_EQ(eeprom_keycode(0, 0, 1), KC_NO);
+
+    dynamic_keymap_set_keycode(0, 0, 2, KC_Z);
+    uint8_t read[4] = {0};
+    dynamic_keymap_get_buffer(2, sizeof(read), read);
+    EXPECT_EQ((read[0] << 8) | read[1], LCTL(KC_C));
+    EXPECT_EQ((read[2] << 8) | read[3], KC_Z);
+}
+
+TEST_F(DynamicKeymapCache, ResetAfterEraseRewritesEveryKey) {
+    const uint8_t         layer_count = dynamic_keymap_get_layer_count();
+    std::vector<uint16_t> expected;
+    for (uint8_t layer = 0; layer < layer_count; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                expected.push_back(dynamic_keymap_get_keycode(layer, row, column));
+
+                // Erase the EEPROM underneath the cache, as eeconfig_init_quantum() does
+                uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, column);
+                eeprom_update_byte(address, 0xFF);
+                eeprom_update_byte(address + 1, 0xFF);
+            }
+        }
+    }
+
+    dynamic_keymap_reset();
+    dynamic_keymap_init();
+    auto keycode = expected.begin();
+    for (uint8_t layer = 0; layer < layer_count; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, column), *keycode++) << "layer " << (int)layer << " row " << (int)row << " column " << (int)column;
+            }
+        }
+    }
+}
@@ -0,0 +1,24 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// Overrides sharing a trigger are listed apart from each other, so that the lookup has to keep them in table order
+const key_override_t shift_a_override = ko_make_basic(MOD_MASK_SHIFT, KC_A, KC_B);
+const key_override_t ctrl_a_override  = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_C);
+const key_override_t shift_any_a      = ko_make_basic(MOD_MASK_CS, KC_A, KC_D);
+const key_override_t shift_s_override = ko_make_basic(MOD_MASK_SHIFT, KC_S, KC_E);
+const key_override_t not_alt_d        = ko_make_with_layers_and_negmods(0, KC_D, KC_F, ~0, MOD_MASK_ALT);
+const key_override_t gui_only         = ko_make_basic(MOD_MASK_GUI, KC_NO, KC_G);
+
+// clang-format off
+const key_override_t **key_overrides = (const key_override_t *[]){
+    &shift_s_override,
+    &shift_a_override,
+    &gui_only,
+    &shift_any_a,
+    &ctrl_a_override,
+    &not_alt_d,
+    NULL
+};
+// clang-format on
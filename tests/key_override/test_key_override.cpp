@@ -0,0 +1,164 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::InSequence;
+
+class KeyOverride : public TestFixture {
+   public:
+    KeymapKey key_a{0, 0, 0, KC_A};
+    KeymapKey key_s{0, 1, 0, KC_S};
+    KeymapKey key_d{0, 2, 0, KC_D};
+    KeymapKey key_lsft{0, 3, 0, KC_LSFT};
+    KeymapKey key_lctl{0, 4, 0, KC_LCTL};
+    KeymapKey key_lalt{0, 5, 0, KC_LALT};
+    KeymapKey key_lgui{0, 6, 0, KC_LGUI};
+
+    void set_override_keymap() {
+        set_keymap({key_a, key_s, key_d, key_lsft, key_lctl, key_lalt, key_lgui});
+    }
+};
+
+TEST_F(KeyOverride, TriggerDownWithModifier) {
+    TestDriver driver;
+    set_override_keymap();
+
+    // The trigger modifiers are suppressed while the override is active
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.press();
+    run_one_scan_loop();
+    tap_key(key_a);
+    key_lsft.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, FirstOverrideInTableWins) {
+    TestDriver driver;
+    set_override_keymap();
+
+    // shift_a_override, shift_any_a and ctrl_a_override all match, but shift_a_override comes first in the table
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_LCTL));
+    EXPECT_REPORT(driver, (KC_LCTL, KC_B));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_LCTL));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.press();
+    run_one_scan_loop();
+    key_lctl.press();
+    run_one_scan_loop();
+    tap_key(key_a);
+    key_lctl.release();
+    run_one_scan_loop();
+    key_lsft.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, NecessaryModifierDown) {
+    TestDriver driver;
+    set_override_keymap();
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_S));
+    key_s.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The replacement is deferred until the key repeat delay has passed
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_E));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    key_lsft.press();
+    run_one_scan_loop();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    key_s.release();
+    run_one_scan_loop();
+    key_lsft.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, NegativeModifierUp) {
+    TestDriver driver;
+    set_override_keymap();
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D));
+    key_lalt.press();
+    run_one_scan_loop();
+    key_d.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_F));
+    EXPECT_EMPTY_REPORT(driver);
+    key_lalt.release();
+    run_one_scan_loop();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    key_d.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, UninvolvedModifierDoesNotActivate) {
+    TestDriver driver;
+    set_override_keymap();
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LGUI));
+    EXPECT_REPORT(driver, (KC_LGUI, KC_A));
+    key_lgui.press();
+    run_one_scan_loop();
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Pressing control activates ctrl_a_override, rather than gui_only which comes first in the table but doesn't involve control
+    EXPECT_REPORT(driver, (KC_LGUI));
+    EXPECT_REPORT(driver, (KC_LGUI, KC_C));
+    EXPECT_REPORT(driver, (KC_LGUI, KC_LCTL));
+    EXPECT_REPORT(driver, (KC_LGUI));
+    EXPECT_EMPTY_REPORT(driver);
+    key_lctl.press();
+    run_one_scan_loop();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    key_lctl.release();
+    run_one_scan_loop();
+    key_a.release();
+    run_one_scan_loop();
+    key_lgui.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(KeyOverride, ModifierOnlyOverride) {
+    TestDriver driver;
+    set_override_keymap();
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_G));
+    EXPECT_REPORT(driver, (KC_LGUI));
+    EXPECT_EMPTY_REPORT(driver);
+    key_lgui.press();
+    run_one_scan_loop();
+    idle_for(KEY_OVERRIDE_REPEAT_DELAY);
+    key_lgui.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
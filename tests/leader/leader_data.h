@@ -0,0 +1,23 @@
+// Generated code.
+
+// Leader dictionary (5 entries):
+//   f             -> KC_F1
+//   f d           -> LCTL(KC_D)
+//   f d s         -> KC_F3
+//   a s d f g h j -> KC_F4
+//   KC_SPC 1      -> KC_F5
+
+#define LEADER_DICTIONARY_SIZE 72
+#define LEADER_DICTIONARY_KEYCODES 5
+
+static const uint8_t leader_data[LEADER_DICTIONARY_SIZE] PROGMEM = {0, 3, 4, 11, 0, 9, 45, 0, 44, 63, 0, 0, 1, 22, 16,
+    0, 0, 1, 7, 21, 0, 0, 1, 9, 26, 0, 0, 1, 10, 31, 0, 0, 1, 11, 36, 0, 0, 1, 13, 41, 0, 1, 3, 0, 0, 1, 0, 0, 1, 7, 52,
+    0, 1, 1, 0, 1, 22, 59, 0, 1, 2, 0, 0, 0, 1, 30, 68, 0, 1, 4, 0, 0};
+
+static const uint16_t leader_keycodes[LEADER_DICTIONARY_KEYCODES] PROGMEM = {
+    KC_F1,
+    LCTL(KC_D),
+    KC_F3,
+    KC_F4,
+    KC_F5,
+};
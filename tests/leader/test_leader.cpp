@@ -0,0 +1,125 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+static unsigned leader_end_count = 0;
+
+void leader_end(void) {
+    leader_end_count++;
+}
+}
+
+class Leader : public TestFixture {
+   public:
+    void SetUp() override {
+        leader_end_count = 0;
+    }
+
+    KeymapKey key_lead{0, 0, 0, QK_LEADER};
+    KeymapKey key_a{0, 1, 0, KC_A};
+    KeymapKey key_s{0, 2, 0, KC_S};
+    KeymapKey key_d{0, 3, 0, KC_D};
+    KeymapKey key_f{0, 4, 0, KC_F};
+    KeymapKey key_g{0, 5, 0, KC_G};
+    KeymapKey key_h{0, 6, 0, KC_H};
+    KeymapKey key_j{0, 7, 0, KC_J};
+    KeymapKey key_x{0, 8, 0, KC_X};
+    KeymapKey key_spc{0, 9, 0, KC_SPC};
+    KeymapKey key_1{0, 10, 0, KC_1};
+
+    void set_leader_keymap() {
+        set_keymap({key_lead, key_a, key_s, key_d, key_f, key_g, key_h, key_j, key_x, key_spc, key_1});
+    }
+};
+
+TEST_F(Leader, UnambiguousSequenceFiresWithoutTimeout) {
+    TestDriver driver;
+    set_leader_keymap();
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_spc);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F5));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, SequenceLongerThanFiveKeys) {
+    TestDriver driver;
+    set_leader_keymap();
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_a, key_s, key_d, key_f, key_g, key_h);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F4));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_j);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, PrefixSequenceFiresOnTimeout) {
+    TestDriver driver;
+    set_leader_keymap();
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_f);
+    idle_for(LEADER_TIMEOUT - 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(20);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, LongerSequenceSharingPrefix) {
+    TestDriver driver;
+    set_leader_keymap();
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F3));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_keys(key_lead, key_f, key_d, key_s);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(LEADER_TIMEOUT * 2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, UnknownSequenceEndsOnTimeout) {
+    TestDriver driver;
+    set_leader_keymap();
+
+    EXPECT_NO_REPORT(driver);
+    tap_keys(key_lead, key_f, key_x);
+    idle_for(LEADER_TIMEOUT + 10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    EXPECT_EQ(leader_end_count, 1);
+
+    // Keys are typed normally again afterwards
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,11 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define IGNORE_MOD_TAP_INTERRUPT
+
+// Small enough for a single scan to overflow it
+#define MATRIX_EVENT_QUEUE_SIZE 2
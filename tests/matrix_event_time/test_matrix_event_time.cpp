@@ -0,0 +1,202 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" void advance_time(uint32_t ms);
+
+static std::vector<keyevent_t> key_presses;
+static uint32_t                processing_time = 0;
+static uint16_t                row_backdate[MATRIX_ROWS] = {0};
+
+extern "C" uint16_t matrix_event_time(uint8_t row, uint16_t scan_time) {
+    // Stands in for the other half of a split keyboard, which reports its changes late
+    return scan_time - row_backdate[row];
+}
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    if (record->event.pressed) {
+        key_presses.push_back(record->event);
+    }
+    // Stands in for processing which takes a while, e.g. a macro
+    advance_time(processing_time);
+    return true;
+}
+
+class MatrixEventTime : public TestFixture {
+   public:
+    KeymapKey key_a{0, 1, 0, KC_A};
+    KeymapKey key_b{0, 2, 0, KC_B};
+    KeymapKey key_c{0, 1, 1, KC_C};
+    KeymapKey mod_tap_key{0, 0, 0, SFT_T(KC_P)};
+    KeymapKey late_key{0, 0, 1, KC_A};
+
+    void SetUp() override {
+        key_presses.clear();
+        processing_time = 0;
+        memset(row_backdate, 0, sizeof(row_backdate));
+        set_keymap({key_a, key_b, key_c, mod_tap_key, late_key});
+    }
+};
+
+TEST_F(MatrixEventTime, EventsShareTheTimeOfTheirScan) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_C));
+    processing_time = 10;
+    uint16_t scan_time = timer_read() | 1;
+    key_a.press();
+    key_c.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Processing the first event took a while, but the second is still stamped with the start of the scan
+    ASSERT_EQ(key_presses.size(), 2u);
+    EXPECT_EQ(key_presses[0].key.row, 0);
+    EXPECT_EQ(key_presses[0].time, scan_time);
+    EXPECT_EQ(key_presses[1].key.row, 1);
+    EXPECT_EQ(key_presses[1].time, scan_time);
+
+    processing_time = 0;
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_c.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(MatrixEventTime, EventsOfARowAreQueuedByColumn) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_b.press();
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(MatrixEventTime, OverflowIsPickedUpByTheNextScan) {
+    TestDriver driver;
+    InSequence s;
+
+    // Only two of the three changes fit into the queue
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    advance_time(10);
+    uint16_t scan_time = timer_read() | 1;
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    ASSERT_EQ(key_presses.size(), 3u);
+    EXPECT_EQ(key_presses[2].time, scan_time);
+    EXPECT_NE(key_presses[2].time, key_presses[0].time);
+
+    EXPECT_REPORT(driver, (KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    run_one_scan_loop();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(MatrixEventTime, BackdatedEventDoesNotPrecedeEarlierEvents) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    idle_for(10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The late key changed before the mod-tap key was pressed, but is only seen after it
+    row_backdate[1] = 50;
+    EXPECT_NO_REPORT(driver);
+    late_key.press();
+    run_one_scan_loop();
+    late_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Still a tap, as all events stayed within the tapping term
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_REPORT(driver, (KC_P, KC_A));
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(MatrixEventTime, BackdatedEventTimeIsKept) {
+    TestDriver driver;
+    InSequence s;
+
+    // The mod-tap key turns into a hold by the time it was pressed at, not by the time it was seen at
+    row_backdate[0] = 50;
+    EXPECT_NO_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    idle_for(TAPPING_TERM - 60);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    row_backdate[0] = 0;
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(20);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(MatrixEventTime, LongPauseDoesNotHoldTimesBack) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(late_key);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Long enough for the 16 bit event times to look like they went backwards
+    idle_for(UINT16_MAX / 2 + 1000);
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.press();
+    idle_for(TAPPING_TERM + 1);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,58 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <initializer_list>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "keycode.h"
+#include "report.h"
+}
+
+namespace {
+report_keyboard_t make_report(uint8_t mods, std::initializer_list<uint8_t> keys) {
+    report_keyboard_t report = {};
+    report.mods              = mods;
+    for (uint8_t key : keys) {
+        add_key_to_report(&report, key);
+    }
+    return report;
+}
+
+bool can_merge(report_keyboard_t sent, report_keyboard_t pending, report_keyboard_t next) {
+    return can_merge_keyboard_reports(&sent, &pending, &next);
+}
+} // namespace
+
+TEST(ReportCoalescing, MergesReleases) {
+    EXPECT_TRUE(can_merge(make_report(0, {KC_A, KC_B}), make_report(0, {KC_B}), make_report(0, {})));
+    EXPECT_TRUE(can_merge(make_report(MOD_BIT(KC_LEFT_SHIFT), {KC_A}), make_report(MOD_BIT(KC_LEFT_SHIFT), {}), make_report(0, {})));
+}
+
+TEST(ReportCoalescing, MergesReleaseFollowingPress) {
+    // Rolling from A to B, the release of A can go out together with the press of B
+    EXPECT_TRUE(can_merge(make_report(0, {KC_A}), make_report(0, {KC_A, KC_B}), make_report(0, {KC_B})));
+}
+
+TEST(ReportCoalescing, MergesPressFollowingModifiers) {
+    // The host applies the modifiers before the keys of a report
+    EXPECT_TRUE(can_merge(make_report(0, {}), make_report(MOD_BIT(KC_LEFT_SHIFT), {}), make_report(MOD_BIT(KC_LEFT_SHIFT), {KC_A})));
+    EXPECT_TRUE(can_merge(make_report(MOD_BIT(KC_LEFT_SHIFT), {KC_A}), make_report(0, {KC_A}), make_report(0, {})));
+}
+
+TEST(ReportCoalescing, SplitsConsecutivePresses) {
+    EXPECT_FALSE(can_merge(make_report(0, {}), make_report(0, {KC_A}), make_report(0, {KC_A, KC_B})));
+}
+
+TEST(ReportCoalescing, SplitsModifiersFollowingPress) {
+    // Shift released after A was pressed must not turn A into a lowercase a
+    EXPECT_FALSE(can_merge(make_report(MOD_BIT(KC_LEFT_SHIFT), {}), make_report(MOD_BIT(KC_LEFT_SHIFT), {KC_A}), make_report(0, {KC_A})));
+    EXPECT_FALSE(can_merge(make_report(0, {}), make_report(0, {KC_A}), make_report(MOD_BIT(KC_LEFT_CTRL), {KC_A})));
+}
+
+TEST(ReportCoalescing, SplitsRepeatedChanges) {
+    // A tap would be lost entirely
+    EXPECT_FALSE(can_merge(make_report(0, {KC_B}), make_report(0, {KC_A, KC_B}), make_report(0, {KC_B})));
+    EXPECT_FALSE(can_merge(make_report(0, {KC_A}), make_report(0, {}), make_report(0, {KC_A})));
+    EXPECT_FALSE(can_merge(make_report(0, {}), make_report(MOD_BIT(KC_LEFT_GUI), {}), make_report(0, {})));
+}
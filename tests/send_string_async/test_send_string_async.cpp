@@ -0,0 +1,149 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {
+   protected:
+    /**
+     * Runs scan loops until the asynchronous engine has finished, returning the number of loops it took.
+     */
+    unsigned run_until_idle(unsigned limit = 1000) {
+        unsigned loops = 0;
+        while (send_string_async_is_busy() && loops < limit) {
+            run_one_scan_loop();
+            loops++;
+        }
+        EXPECT_FALSE(send_string_async_is_busy()) << "String was not typed out";
+        return loops;
+    }
+};
+
+TEST_F(SendStringAsync, ReturnsBeforeTyping) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    SEND_STRING_ASYNC("a");
+    EXPECT_TRUE(send_string_async_is_busy());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    run_until_idle();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, SendsOneReportPerScan) {
+    TestDriver driver;
+    InSequence s;
+
+    SEND_STRING_ASYNC("aB" SS_TAP(X_ENTER));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_EQ(run_until_idle(), 8);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, KeepsScanningWhileTyping) {
+    TestDriver driver;
+    KeymapKey  ctrl = KeymapKey(0, 0, 0, KC_LEFT_CTRL);
+    set_keymap({ctrl});
+
+    SEND_STRING_ASYNC("a" SS_DELAY(50) "b");
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(10);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // A key pressed during the delay is reported straight away
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    ctrl.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(30);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The held modifier is left out while typing, and reported again afterwards
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    run_until_idle();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    ctrl.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, KeepsHeldModifiers) {
+    TestDriver driver;
+    KeymapKey  shift = KeymapKey(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_a = KeymapKey(0, 1, 0, KC_A);
+    set_keymap({shift, key_a});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    shift.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Releasing the shift of the typed 'B' doesn't release the held one
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    SEND_STRING_ASYNC("B");
+    run_until_idle();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    shift.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(SendStringAsync, TypesQueuedStringsInOrder) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_1));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_2));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_3));
+    EXPECT_EMPTY_REPORT(driver);
+
+    SEND_STRING_ASYNC("1");
+    SEND_STRING_ASYNC("2");
+    // Only two strings can be pending, so this blocks until the first one has been typed out
+    SEND_STRING_ASYNC("3");
+    run_until_idle();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
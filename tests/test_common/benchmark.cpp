@@ -0,0 +1,200 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "benchmark.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "gtest/gtest.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#endif
+
+extern "C" {
+#include "debug.h"
+}
+
+namespace {
+/* Must follow the order of benchmark_probe_t. */
+const char* probe_names[BENCHMARK_PROBE_COUNT] = {
+    "matrix_task",
+    "quantum_task",
+    "action_exec",
+    "host_keyboard_send",
+    "key_override",
+    "hsv_to_rgb",
+    "hsv_to_rgb_batch",
+    "wear_leveling_init",
+};
+
+/* Uses the time stamp counter where available, so results are in CPU cycles.
+ * Other hosts fall back to nanoseconds of the monotonic clock. */
+inline uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+} // namespace
+
+/* Called from the firmware through the BENCHMARK_PROBE_ENTER/EXIT macros. */
+extern "C" void benchmark_probe_enter(benchmark_probe_t probe) {
+    if (BenchmarkFixture::m_bench) {
+        BenchmarkFixture::m_bench->probe_enter(probe);
+    }
+}
+
+extern "C" void benchmark_probe_exit(benchmark_probe_t probe) {
+    if (BenchmarkFixture::m_bench) {
+        BenchmarkFixture::m_bench->probe_exit(probe);
+    }
+}
+
+void BenchmarkProbeStats::add(uint64_t cycles) {
+    m_samples.push_back(cycles);
+    m_sorted = false;
+}
+
+void BenchmarkProbeStats::clear() {
+    m_samples.clear();
+    m_sorted = true;
+}
+
+size_t BenchmarkProbeStats::count() const {
+    return m_samples.size();
+}
+
+uint64_t BenchmarkProbeStats::percentile(unsigned pct) const {
+    if (m_samples.empty()) {
+        return 0;
+    }
+    if (!m_sorted) {
+        std::sort(m_samples.begin(), m_samples.end());
+        m_sorted = true;
+    }
+    size_t index = (m_samples.size() * pct) / 100;
+    return m_samples[std::min(index, m_samples.size() - 1)];
+}
+
+uint64_t BenchmarkProbeStats::max() const {
+    return percentile(100);
+}
+
+BenchmarkFixture* BenchmarkFixture::m_bench = nullptr;
+
+BenchmarkFixture::BenchmarkFixture() : m_driver{&BenchmarkFixture::keyboard_leds, &BenchmarkFixture::send_keyboard, &BenchmarkFixture::send_mouse, &BenchmarkFixture::send_extra} {
+    /* Debug output would dominate every measurement. */
+    m_debug_config   = debug_config.raw;
+    debug_config.raw = 0;
+
+    host_set_driver(&m_driver);
+    m_bench = this;
+}
+
+BenchmarkFixture::~BenchmarkFixture() {
+    m_bench = nullptr;
+    host_set_driver(nullptr);
+    debug_config.raw = m_debug_config;
+
+    print_report();
+}
+
+void BenchmarkFixture::type_keys(const std::vector<KeymapKey>& keys, unsigned hold_ms, unsigned gap_ms) {
+    for (KeymapKey key : keys) {
+        key.press();
+        idle_for(hold_ms);
+        key.release();
+        idle_for(gap_ms);
+    }
+}
+
+void BenchmarkFixture::roll_keys(const std::vector<KeymapKey>& keys, unsigned step_ms, unsigned overlap_ms) {
+    overlap_ms = std::min(overlap_ms, step_ms);
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        KeymapKey key = keys[i];
+        key.press();
+        if (i > 0) {
+            idle_for(overlap_ms);
+            KeymapKey previous = keys[i - 1];
+            previous.release();
+            idle_for(step_ms - overlap_ms);
+        } else {
+            idle_for(step_ms);
+        }
+    }
+
+    if (!keys.empty()) {
+        KeymapKey last = keys.back();
+        last.release();
+        idle_for(step_ms);
+    }
+}
+
+void BenchmarkFixture::chord_keys(const std::vector<KeymapKey>& keys, unsigned hold_ms) {
+    for (KeymapKey key : keys) {
+        key.press();
+    }
+    idle_for(hold_ms);
+    for (KeymapKey key : keys) {
+        key.release();
+    }
+    idle_for(hold_ms);
+}
+
+void BenchmarkFixture::reset_probes() {
+    for (auto& stats : m_stats) {
+        stats.clear();
+    }
+    m_reports = 0;
+}
+
+const BenchmarkProbeStats& BenchmarkFixture::probe_stats(benchmark_probe_t probe) const {
+    return m_stats[probe];
+}
+
+size_t BenchmarkFixture::reports_sent() const {
+    return m_reports;
+}
+
+void BenchmarkFixture::probe_enter(benchmark_probe_t probe) {
+    m_started[probe] = read_cycles();
+}
+
+void BenchmarkFixture::probe_exit(benchmark_probe_t probe) {
+    m_stats[probe].add(read_cycles() - m_started[probe]);
+}
+
+uint8_t BenchmarkFixture::keyboard_leds(void) {
+    return 0;
+}
+
+void BenchmarkFixture::send_keyboard(report_keyboard_t* report) {
+    m_bench->m_reports++;
+}
+
+void BenchmarkFixture::send_mouse(report_mouse_t* report) {}
+
+void BenchmarkFixture::send_extra(report_extra_t* report) {}
+
+void BenchmarkFixture::print_report() const {
+    const ::testing::TestInfo* const test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+
+    printf("%s.%s: %zu reports\n", test_info->test_case_name(), test_info->name(), m_reports);
+    printf("    %-20s %10s %10s %10s %10s\n", "probe", "samples", "p50", "p99", "max");
+    for (int i = 0; i < BENCHMARK_PROBE_COUNT; i++) {
+        const BenchmarkProbeStats& stats = m_stats[i];
+        if (!stats.count()) {
+            continue;
+        }
+
+        printf("    %-20s %10zu %10llu %10llu %10llu\n", probe_names[i], stats.count(), (unsigned long long)stats.percentile(50), (unsigned long long)stats.percentile(99), (unsigned long long)stats.max());
+
+        std::string name = probe_names[i];
+        ::testing::Test::RecordProperty(name + "_p50", std::to_string(stats.percentile(50)));
+        ::testing::Test::RecordProperty(name + "_p99", std::to_string(stats.percentile(99)));
+        ::testing::Test::RecordProperty(name + "_max", std::to_string(stats.max()));
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "benchmark_probe.h"
+#include "host.h"
+}
+
+/**
+ * @brief Collected samples of a single benchmark probe, in cycles.
+ */
+class BenchmarkProbeStats {
+   public:
+    void     add(uint64_t cycles);
+    void     clear();
+    size_t   count() const;
+    uint64_t percentile(unsigned pct) const;
+    uint64_t max() const;
+
+   private:
+    mutable std::vector<uint64_t> m_samples;
+    mutable bool                  m_sorted = true;
+};
+
+/**
+ * @brief Test fixture for scan loop benchmarks.
+ *
+ * Replaces the gmock backed TestDriver with a host driver that only counts the
+ * reports it receives, silences debug output and records the cycles spent
+ * between each BENCHMARK_PROBE_ENTER/BENCHMARK_PROBE_EXIT pair in the
+ * firmware. The p50/p99/max of every probe are printed when the fixture is
+ * torn down and recorded as test properties, so that
+ * `--gtest_output=xml:<file>` can be used to track them over time.
+ */
+class BenchmarkFixture : public TestFixture {
+   public:
+    BenchmarkFixture();
+    ~BenchmarkFixture();
+
+    /**
+     * @brief Taps each key of `keys` in order, holding each for `hold_ms` and
+     * idling for `gap_ms` after each release.
+     */
+    void type_keys(const std::vector<KeymapKey>& keys, unsigned hold_ms = 30, unsigned gap_ms = 50);
+
+    /**
+     * @brief Rolls over `keys`: each key is pressed `step_ms` after the
+     * previous one and released `overlap_ms` after the next one was pressed.
+     */
+    void roll_keys(const std::vector<KeymapKey>& keys, unsigned step_ms = 20, unsigned overlap_ms = 10);
+
+    /**
+     * @brief Presses all `keys` within a single scan, holds them for
+     * `hold_ms` and releases them within a single scan again.
+     */
+    void chord_keys(const std::vector<KeymapKey>& keys, unsigned hold_ms = 30);
+
+    /**
+     * @brief Discards all samples collected so far, e.g. after warming up.
+     */
+    void reset_probes();
+
+    const BenchmarkProbeStats& probe_stats(benchmark_probe_t probe) const;
+    size_t                     reports_sent() const;
+
+    void probe_enter(benchmark_probe_t probe);
+    void probe_exit(benchmark_probe_t probe);
+
+    static BenchmarkFixture* m_bench;
+
+   private:
+    static uint8_t keyboard_leds(void);
+    static void    send_keyboard(report_keyboard_t* report);
+    static void    send_mouse(report_mouse_t* report);
+    static void    send_extra(report_extra_t* report);
+    void           print_report() const;
+
+    host_driver_t                                          m_driver;
+    std::array<BenchmarkProbeStats, BENCHMARK_PROBE_COUNT> m_stats;
+    std::array<uint64_t, BENCHMARK_PROBE_COUNT>            m_started = {};
+    size_t                                                 m_reports = 0;
+    uint8_t                                                m_debug_config;
+};
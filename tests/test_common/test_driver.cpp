@@ -15,6 +15,7 @@
  */
 
 #include "test_driver.hpp"
+#include <algorithm>
 
 TestDriver* TestDriver::m_this = nullptr;
 
@@ -62,7 +63,9 @@ void expect_unicode_code_point(TestDriver& driver, uint32_t code_point) {
     testing::InSequence seq;
     EXPECT_REPORT(driver, (KC_LCTL, KC_LSFT, KC_U));
 
-    bool print_zero = false;
+    // Digits are held down as they're typed, and only released when one repeats
+    std::vector<uint8_t> held;
+    bool                 print_zero = false;
     for (int i = 7; i >= 0; --i) {
         if (i <= 3) {
             print_zero = true;
@@ -70,7 +73,12 @@ void expect_unicode_code_point(TestDriver& driver, uint32_t code_point) {
 
         const uint8_t digit = (code_point >> (i * 4)) & 0xf;
         if (digit || print_zero) {
-            EXPECT_REPORT(driver, (hex_digit_to_keycode(digit)));
+            const uint8_t keycode = hex_digit_to_keycode(digit);
+            if (std::find(held.begin(), held.end(), keycode) != held.end()) {
+                held.clear();
+            }
+            held.push_back(keycode);
+            EXPECT_CALL(driver, send_keyboard_mock(testing::MakeMatcher(new KeyboardReportMatcher(held))));
             print_zero = true;
         }
     }
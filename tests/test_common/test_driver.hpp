@@ -72,6 +72,9 @@ class TestDriver {
  * expects the sequence of keys:
  *
  *   "Ctrl+Shift+U, 2, 0, 1, 3, space".
+ *
+ * The hex digits are held down as they're typed, so the reports for them are (2), (2, 0),
+ * (2, 0, 1), and (2, 0, 1, 3). Reports in which keys are only released are not expected.
  */
 #define EXPECT_UNICODE(driver, code_point) internal::expect_unicode_code_point((driver), (code_point))
 
@@ -0,0 +1,88 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "unicode.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::AnyOf;
+using testing::InSequence;
+
+class Unicode : public TestFixture {};
+
+TEST_F(Unicode, LinuxDigitsHeldUntilRepeat) {
+    TestDriver driver;
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    EXPECT_CALL(driver, send_keyboard_mock(AnyOf(KeyboardReport(), KeyboardReport(KC_LCTL, KC_LSFT)))).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_UNICODE(driver, 0x2022);
+        EXPECT_UNICODE(driver, 0x00E4);
+    }
+    send_unicode_string("•ä");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Unicode, MacOSSessionSpansString) {
+    TestDriver driver;
+    set_unicode_input_mode(UNICODE_MODE_MACOS);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_LALT));
+    // U+00E9
+    EXPECT_REPORT(driver, (KC_LALT, KC_0));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_0));
+    EXPECT_REPORT(driver, (KC_LALT, KC_0, KC_E));
+    EXPECT_REPORT(driver, (KC_LALT, KC_0, KC_E, KC_9));
+    EXPECT_REPORT(driver, (KC_LALT));
+    // U+1F600, as the surrogate pair D83D DE00
+    EXPECT_REPORT(driver, (KC_LALT, KC_D));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D, KC_8));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D, KC_8, KC_3));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_LALT, KC_D, KC_E, KC_0));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_REPORT(driver, (KC_LALT, KC_0));
+    EXPECT_REPORT(driver, (KC_LALT));
+    EXPECT_EMPTY_REPORT(driver);
+    send_unicode_string("é😀");
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(Unicode, ReleasesWhenReportIsFull) {
+    TestDriver driver;
+    set_unicode_input_mode(UNICODE_MODE_LINUX);
+
+    // Leave room for only two digits in the report
+    ::add_key(KC_F1);
+    ::add_key(KC_F2);
+    ::add_key(KC_F3);
+    ::add_key(KC_F4);
+
+    InSequence s;
+    EXPECT_REPORT(driver, (KC_F1, KC_F2, KC_F3, KC_F4, KC_1));
+    EXPECT_REPORT(driver, (KC_F1, KC_F2, KC_F3, KC_F4, KC_1, KC_2));
+    EXPECT_REPORT(driver, (KC_F1, KC_F2, KC_F3, KC_F4));
+    EXPECT_REPORT(driver, (KC_F1, KC_F2, KC_F3, KC_F4, KC_3));
+    EXPECT_REPORT(driver, (KC_F1, KC_F2, KC_F3, KC_F4, KC_3, KC_4));
+    EXPECT_REPORT(driver, (KC_F1, KC_F2, KC_F3, KC_F4));
+    register_hex(0x1234);
+
+    EXPECT_EMPTY_REPORT(driver);
+    clear_keyboard();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -48,6 +48,9 @@
 #endif
 #include "suspend.h"
 #include "wait.h"
+#ifdef I2C_ASYNC_ENABLE
+#    include "i2c_master.h"
+#endif
 
 /* -------------------------
  *   TMK host driver defs
@@ -215,4 +218,7 @@ void protocol_post_task(void) {
 #ifdef RAW_ENABLE
     raw_hid_task();
 #endif
+#ifdef I2C_ASYNC_ENABLE
+    i2c_async_task();
+#endif
 }
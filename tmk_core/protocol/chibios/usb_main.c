@@ -76,6 +76,13 @@ static void keyboard_idle_timer_cb(void *arg);
 #endif
 
 report_keyboard_t keyboard_report_sent = {{0}};
+#ifdef KEYBOARD_REPORT_COALESCING
+/* Report waiting for the keyboard endpoint to become free, sent on the next SOF */
+static report_keyboard_t keyboard_report_pending       = {{0}};
+static bool              keyboard_report_pending_valid = false;
+
+static void keyboard_report_sof_hook_i(void);
+#endif
 #ifdef MOUSE_ENABLE
 report_mouse_t mouse_report_blank = {0};
 #endif /* MOUSE_ENABLE */
@@ -497,6 +504,10 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
 
         case USB_EVENT_CONFIGURED:
             osalSysLockFromISR();
+#ifdef KEYBOARD_REPORT_COALESCING
+            /* A report left over from before must not reach the new configuration. */
+            keyboard_report_pending_valid = false;
+#endif
             /* Enable the endpoints specified into the configuration. */
 #ifndef KEYBOARD_SHARED_EP
             usbInitEndpointI(usbp, KEYBOARD_IN_EPNUM, &kbd_ep_config);
@@ -536,6 +547,12 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
         case USB_EVENT_UNCONFIGURED:
             /* Falls into.*/
         case USB_EVENT_RESET:
+#ifdef KEYBOARD_REPORT_COALESCING
+            /* Drop the pending report, so the SOF hook can't send it stale after resume. */
+            osalSysLockFromISR();
+            keyboard_report_pending_valid = false;
+            osalSysUnlockFromISR();
+#endif
             usb_event_queue_enqueue(event);
             for (int i = 0; i < NUM_USB_DRIVERS; i++) {
                 chSysLockFromISR();
@@ -724,6 +741,9 @@ static void usb_sof_cb(USBDriver *usbp) {
     for (int i = 0; i < NUM_USB_DRIVERS; i++) {
         qmkusbSOFHookI(&drivers.array[i].driver);
     }
+#ifdef KEYBOARD_REPORT_COALESCING
+    keyboard_report_sof_hook_i();
+#endif
     osalSysUnlockFromISR();
 }
 
@@ -836,6 +856,84 @@ uint8_t keyboard_leds(void) {
     return keyboard_led_state;
 }
 
+#ifdef KEYBOARD_REPORT_COALESCING
+static usbep_t keyboard_report_endpoint(void) {
+#    ifdef NKRO_ENABLE
+    if (keymap_config.nkro && keyboard_protocol) {
+        return SHARED_IN_EPNUM;
+    }
+#    endif
+    return KEYBOARD_IN_EPNUM;
+}
+
+/* start sending keyboard_report_sent, the endpoint must be idle */
+static void keyboard_report_transmit_i(void) {
+#    ifdef NKRO_ENABLE
+    if (keymap_config.nkro && keyboard_protocol) {
+        usbStartTransmitI(&USB_DRIVER, SHARED_IN_EPNUM, (uint8_t *)&keyboard_report_sent, sizeof(struct nkro_report));
+        return;
+    }
+#    endif
+    if (keyboard_protocol) {
+        usbStartTransmitI(&USB_DRIVER, KEYBOARD_IN_EPNUM, (uint8_t *)&keyboard_report_sent, KEYBOARD_REPORT_SIZE);
+    } else { /* boot protocol */
+        usbStartTransmitI(&USB_DRIVER, KEYBOARD_IN_EPNUM, &keyboard_report_sent.mods, 8);
+    }
+}
+
+/* hand the pending report over at the start of the frame, so it goes out with the next poll of the host */
+static void keyboard_report_sof_hook_i(void) {
+    if (keyboard_report_pending_valid && usbGetDriverStateI(&USB_DRIVER) == USB_ACTIVE && !usbGetTransmitStatusI(&USB_DRIVER, keyboard_report_endpoint())) {
+        keyboard_report_sent          = keyboard_report_pending;
+        keyboard_report_pending_valid = false;
+        keyboard_report_transmit_i();
+    }
+}
+
+/* queue a report IN without waiting for the endpoint, merging it with
+ * the pending one as long as the host still sees the same events
+ * not callable from ISR or locked state */
+void send_keyboard(report_keyboard_t *report) {
+    osalSysLock();
+    if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+        goto unlock;
+    }
+
+    usbep_t ep = keyboard_report_endpoint();
+    if (keyboard_report_pending_valid) {
+        if (can_merge_keyboard_reports(&keyboard_report_sent, &keyboard_report_pending, report)) {
+            keyboard_report_pending = *report;
+            goto unlock;
+        }
+
+        /* merging would lose events, so the pending report has to go first */
+        if (usbGetTransmitStatusI(&USB_DRIVER, ep)) {
+            osalThreadSuspendS(&(&USB_DRIVER)->epc[ep]->in_state->thread);
+
+            /* after osalThreadSuspendS returns USB status might have changed */
+            if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+                goto unlock;
+            }
+        }
+        if (keyboard_report_pending_valid) {
+            keyboard_report_sent          = keyboard_report_pending;
+            keyboard_report_pending_valid = false;
+            keyboard_report_transmit_i();
+        }
+    }
+
+    if (usbGetTransmitStatusI(&USB_DRIVER, ep)) {
+        keyboard_report_pending       = *report;
+        keyboard_report_pending_valid = true;
+    } else {
+        keyboard_report_sent = *report;
+        keyboard_report_transmit_i();
+    }
+
+unlock:
+    osalSysUnlock();
+}
+#else
 /* prepare and start sending a report IN
  * not callable from ISR or locked state */
 void send_keyboard(report_keyboard_t *report) {
@@ -896,6 +994,7 @@ void send_keyboard(report_keyboard_t *report) {
 unlock:
     osalSysUnlock();
 }
+#endif
 
 /* ---------------------------------------------------------
  *                     Mouse functions
@@ -279,6 +279,68 @@ void clear_keys_from_report(report_keyboard_t* keyboard_report) {
     memset(keyboard_report->keys, 0, sizeof(keyboard_report->keys));
 }
 
+#define REPORT_CHANGE_MODS 0x01
+#define REPORT_CHANGE_RELEASE 0x02
+#define REPORT_CHANGE_PRESS 0x04
+
+static uint8_t report_key_changes(uint8_t before, uint8_t after) {
+    return ((before & ~after) ? REPORT_CHANGE_RELEASE : 0) | ((after & ~before) ? REPORT_CHANGE_PRESS : 0);
+}
+
+/** \brief Checks if a report can replace a pending one without the host seeing different events
+ *
+ * The host applies the modifiers of a report before its keys, and can't tell in which order keys within one report
+ * were pressed. So `next` can only replace `pending` if no key or modifier changes in both steps from `sent`, and if
+ * a key press in `pending` isn't followed by another key press or a modifier change in `next`.
+ *
+ * \param sent The last report handed to the host.
+ * \param pending The report waiting to be sent.
+ * \param next The report which would replace it.
+ */
+bool can_merge_keyboard_reports(report_keyboard_t* sent, report_keyboard_t* pending, report_keyboard_t* next) {
+    uint8_t first  = 0;
+    uint8_t second = 0;
+    uint8_t twice  = 0;
+
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        twice |= (sent->nkro.mods ^ pending->nkro.mods) & (pending->nkro.mods ^ next->nkro.mods);
+        first |= sent->nkro.mods != pending->nkro.mods ? REPORT_CHANGE_MODS : 0;
+        second |= pending->nkro.mods != next->nkro.mods ? REPORT_CHANGE_MODS : 0;
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_BITS; i++) {
+            uint8_t s = sent->nkro.bits[i], p = pending->nkro.bits[i], n = next->nkro.bits[i];
+            twice |= (s ^ p) & (p ^ n);
+            first |= report_key_changes(s, p);
+            second |= report_key_changes(p, n);
+        }
+    } else
+#endif
+    {
+        twice |= (sent->mods ^ pending->mods) & (pending->mods ^ next->mods);
+        first |= sent->mods != pending->mods ? REPORT_CHANGE_MODS : 0;
+        second |= pending->mods != next->mods ? REPORT_CHANGE_MODS : 0;
+
+        // Only the keys present in any of the reports can have changed
+        report_keyboard_t* reports[] = {sent, pending, next};
+        for (uint8_t r = 0; r < 3; r++) {
+            for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                uint8_t key = reports[r]->keys[i];
+                if (key) {
+                    uint8_t s = is_key_pressed(sent, key), p = is_key_pressed(pending, key), n = is_key_pressed(next, key);
+                    twice |= (s ^ p) & (p ^ n);
+                    first |= report_key_changes(s, p);
+                    second |= report_key_changes(p, n);
+                }
+            }
+        }
+    }
+
+    if (twice) {
+        return false;
+    }
+    return !((first & REPORT_CHANGE_PRESS) && (second & (REPORT_CHANGE_PRESS | REPORT_CHANGE_MODS)));
+}
+
 #ifdef MOUSE_ENABLE
 /**
  * @brief Compares 2 mouse reports for difference and returns result
@@ -337,6 +337,7 @@ void del_key_bit(report_keyboard_t* keyboard_report, uint8_t code);
 void add_key_to_report(report_keyboard_t* keyboard_report, uint8_t key);
 void del_key_from_report(report_keyboard_t* keyboard_report, uint8_t key);
 void clear_keys_from_report(report_keyboard_t* keyboard_report);
+bool can_merge_keyboard_reports(report_keyboard_t* sent, report_keyboard_t* pending, report_keyboard_t* next);
 
 #ifdef MOUSE_ENABLE
 bool has_mouse_report_changed(report_mouse_t* new_report, report_mouse_t* old_report);